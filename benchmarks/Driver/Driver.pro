@@ -0,0 +1,37 @@
+#-------------------------------------------------
+#
+# Benchmarks of the driver against the in process
+# stand-in server, needs no running ArangoDB
+#
+#-------------------------------------------------
+
+QT       += testlib network
+
+QT       -= gui
+
+TARGET = tst_DriverBenchmark
+CONFIG   += console
+CONFIG   -= app_bundle
+
+TEMPLATE = app
+
+QMAKE_CXXFLAGS += -std=c++11
+
+SOURCES += tst_DriverBenchmark.cpp
+DEFINES += SRCDIR=\\\"$$PWD/\\\"
+
+include(../common/common.pri)
+
+win32:CONFIG(release, debug|release): LIBS += -L$$PWD/../../../arangodb-driver-dist/release/ -larangodb-driver
+else:win32:CONFIG(debug, debug|release): LIBS += -L$$PWD/../../../arangodb-driver-dist/debug/ -larangodb-driver
+
+else:unix:CONFIG(debug, debug|release): {
+LIBS += -L$$PWD/../../../arangodb-driver-dist/debug/ -larangodb-driver
+DEPENDPATH += $$PWD/../../../arangodb-driver-dist/debug
+}
+else:unix:CONFIG(release, debug|release): {
+LIBS += -L$$PWD/../../../arangodb-driver-dist/release/ -larangodb-driver
+DEPENDPATH += $$PWD/../../../arangodb-driver-dist/release
+}
+
+INCLUDEPATH += $$PWD/../../src
@@ -0,0 +1,295 @@
+/********************************************************************************
+ ** The MIT License (MIT)
+ **
+ ** Copyright (c) 2013 Sascha Ludwig Häusler
+ **
+ ** Permission is hereby granted, free of charge, to any person obtaining a copy of
+ ** this software and associated documentation files (the "Software"), to deal in
+ ** the Software without restriction, including without limitation the rights to
+ ** use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ ** the Software, and to permit persons to whom the Software is furnished to do so,
+ ** subject to the following conditions:
+ **
+ ** The above copyright notice and this permission notice shall be included in all
+ ** copies or substantial portions of the Software.
+ **
+ ** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ ** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ ** FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ ** COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ ** IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ ** CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *********************************************************************************/
+
+#include <QtTest>
+#include <QtCore>
+#include <QtNetwork>
+#include <Arangodbdriver.h>
+#include <QueryBuilder.h>
+
+#include "ArangoStandIn.h"
+
+using namespace arangodb;
+
+/**
+ * @brief Measures the driver against the in process stand-in
+ * server, so the numbers only contain the work of the driver,
+ * the local HTTP round trips and the configured latency
+ */
+class DriverBenchmark : public QObject
+{
+        Q_OBJECT
+
+    public:
+        DriverBenchmark();
+
+    private Q_SLOTS:
+        void initTestCase();
+        void cleanupTestCase();
+        void benchDocumentCreate_data();
+        void benchDocumentCreate();
+        void benchDocumentRead();
+        void benchDocumentUpdate();
+        void benchDocumentDelete();
+        void benchCursorScan_data();
+        void benchCursorScan();
+        void benchQueryBuilding_data();
+        void benchQueryBuilding();
+
+    private:
+        /**
+         * @brief Waits until every document is ready or has failed
+         *
+         * @param docs
+         */
+        inline void waitForDocuments(const QList<Document *> & docs) {
+            int remaining = docs.size();
+            QEventLoop loop;
+            for ( Document * doc : docs ) {
+                auto done = [&remaining, &loop] {
+                    if ( --remaining == 0 ) loop.quit();
+                };
+                connect(doc, &Document::ready, &loop, done);
+                connect(doc, &Document::error, &loop, done);
+            }
+
+            if ( remaining > 0 ) loop.exec();
+        }
+
+        /**
+         * @brief Waits until every document is deleted
+         *
+         * @param docs
+         */
+        inline void waitForDeletedDocuments(const QList<Document *> & docs) {
+            int remaining = docs.size();
+            QEventLoop loop;
+            for ( Document * doc : docs ) {
+                connect(doc, &Document::dataDeleted, &loop, [&remaining, &loop] {
+                    if ( --remaining == 0 ) loop.quit();
+                });
+            }
+
+            if ( remaining > 0 ) loop.exec();
+        }
+
+        QList<Document *> createDocuments(int count, int payloadSize);
+
+        static const int DocumentsPerRound = 200;
+
+        ArangoStandIn server;
+        Arangodbdriver * driver;
+        QueryBuilder qb;
+};
+
+DriverBenchmark::DriverBenchmark() :
+    driver(Q_NULLPTR)
+{
+}
+
+void DriverBenchmark::initTestCase()
+{
+    QVERIFY( server.start() );
+    driver = new Arangodbdriver(QStringLiteral("http"), QStringLiteral("127.0.0.1"), server.serverPort());
+}
+
+void DriverBenchmark::cleanupTestCase()
+{
+    delete driver;
+}
+
+QList<Document *> DriverBenchmark::createDocuments(int count, int payloadSize)
+{
+    const QString payload(payloadSize, QChar('x'));
+
+    QList<Document *> docs;
+    for (int i = 0; i < count; ++i) {
+        Document * doc = driver->createDocument(QStringLiteral("bench"));
+        doc->set(QStringLiteral("number"), i);
+        doc->set(QStringLiteral("payload"), payload);
+        doc->save();
+        docs.append(doc);
+    }
+
+    waitForDocuments(docs);
+    return docs;
+}
+
+void DriverBenchmark::benchDocumentCreate_data()
+{
+    QTest::addColumn<int>("payloadSize");
+    QTest::addColumn<int>("latency");
+
+    QTest::newRow("small") << 16 << 0;
+    QTest::newRow("1 KB") << 1024 << 0;
+    QTest::newRow("16 KB") << 16 * 1024 << 0;
+    QTest::newRow("small, 5 ms latency") << 16 << 5;
+}
+
+void DriverBenchmark::benchDocumentCreate()
+{
+    QFETCH(int, payloadSize);
+    QFETCH(int, latency);
+
+    server.setLatency(latency);
+
+    QBENCHMARK {
+        qDeleteAll(createDocuments(DocumentsPerRound, payloadSize));
+    }
+
+    server.setLatency(0);
+    server.truncateCollection(QStringLiteral("bench"));
+}
+
+void DriverBenchmark::benchDocumentRead()
+{
+    QList<Document *> docs = createDocuments(DocumentsPerRound, 1024);
+
+    QBENCHMARK {
+        QList<Document *> loaded;
+        for ( Document * doc : docs ) {
+            loaded.append(driver->getDocument(doc->docID()));
+        }
+
+        waitForDocuments(loaded);
+        qDeleteAll(loaded);
+    }
+
+    qDeleteAll(docs);
+    server.truncateCollection(QStringLiteral("bench"));
+}
+
+void DriverBenchmark::benchDocumentUpdate()
+{
+    QList<Document *> docs = createDocuments(DocumentsPerRound, 1024);
+    int round = 0;
+
+    QBENCHMARK {
+        ++round;
+        for ( Document * doc : docs ) {
+            doc->set(QStringLiteral("round"), round);
+            doc->save();
+        }
+
+        waitForDocuments(docs);
+    }
+
+    qDeleteAll(docs);
+    server.truncateCollection(QStringLiteral("bench"));
+}
+
+void DriverBenchmark::benchDocumentDelete()
+{
+    QBENCHMARK {
+        // Creating the documents is part of every round
+        QList<Document *> docs = createDocuments(DocumentsPerRound, 16);
+        for ( Document * doc : docs ) {
+            doc->drop();
+        }
+
+        waitForDeletedDocuments(docs);
+        qDeleteAll(docs);
+    }
+
+    server.truncateCollection(QStringLiteral("bench"));
+}
+
+void DriverBenchmark::benchCursorScan_data()
+{
+    QTest::addColumn<int>("documents");
+    QTest::addColumn<int>("batchSize");
+    QTest::addColumn<int>("payloadSize");
+    QTest::addColumn<bool>("columnar");
+
+    QTest::newRow("10000 docs, batch 100") << 10000 << 100 << 64 << false;
+    QTest::newRow("10000 docs, batch 1000") << 10000 << 1000 << 64 << false;
+    QTest::newRow("10000 docs, batch 1000, 1 KB") << 10000 << 1000 << 1024 << false;
+    QTest::newRow("10000 docs, batch 1000, columnar") << 10000 << 1000 << 64 << true;
+}
+
+void DriverBenchmark::benchCursorScan()
+{
+    QFETCH(int, documents);
+    QFETCH(int, batchSize);
+    QFETCH(int, payloadSize);
+    QFETCH(bool, columnar);
+
+    server.fillCollection(QStringLiteral("scan"), documents, payloadSize);
+
+    QBENCHMARK {
+        auto select = qb.createSelect(QStringLiteral("scan"), batchSize);
+        select->setColumnar(columnar);
+
+        auto cursor = driver->executeSelect(select);
+        cursor->setBatchRecycling(true);
+        cursor->waitForResult();
+
+        int rows = cursor->count();
+        while ( cursor->hasMore() && !cursor->hasErrorOccurred() ) {
+            if ( columnar ) cursor->clearData();
+            cursor->getMoreData();
+            cursor->waitForResult();
+            rows += cursor->count();
+        }
+
+        QCOMPARE( rows, documents );
+    }
+
+    server.truncateCollection(QStringLiteral("scan"));
+}
+
+void DriverBenchmark::benchQueryBuilding_data()
+{
+    QTest::addColumn<bool>("prepared");
+
+    QTest::newRow("new select") << false;
+    QTest::newRow("prepared select") << true;
+}
+
+void DriverBenchmark::benchQueryBuilding()
+{
+    QFETCH(bool, prepared);
+
+    auto reused = qb.createSelect(QStringLiteral("bench"));
+    reused->setSort(QStringLiteral("number"));
+    reused->setLimit(10, 100);
+
+    int value = 0;
+
+    QBENCHMARK {
+        QSharedPointer<QBSelect> select = reused;
+        if ( !prepared ) {
+            select = qb.createSelect(QStringLiteral("bench"));
+            select->setSort(QStringLiteral("number"));
+            select->setLimit(10, 100);
+        }
+
+        // Only the bound value changes between the rounds
+        select->setWhere(QStringLiteral("number"), QString::number(++value));
+        select->toJson();
+    }
+}
+
+QTEST_MAIN(DriverBenchmark)
+
+#include "tst_DriverBenchmark.moc"
@@ -0,0 +1,35 @@
+#-------------------------------------------------
+#
+# Microbenchmarks of the CPU bound parts of the
+# driver, they do no I/O at all
+#
+#-------------------------------------------------
+
+QT       += testlib network
+
+QT       -= gui
+
+TARGET = tst_MicroBenchmark
+CONFIG   += console
+CONFIG   -= app_bundle
+
+TEMPLATE = app
+
+QMAKE_CXXFLAGS += -std=c++11
+
+SOURCES += tst_MicroBenchmark.cpp
+DEFINES += SRCDIR=\\\"$$PWD/\\\"
+
+win32:CONFIG(release, debug|release): LIBS += -L$$PWD/../../../arangodb-driver-dist/release/ -larangodb-driver
+else:win32:CONFIG(debug, debug|release): LIBS += -L$$PWD/../../../arangodb-driver-dist/debug/ -larangodb-driver
+
+else:unix:CONFIG(debug, debug|release): {
+LIBS += -L$$PWD/../../../arangodb-driver-dist/debug/ -larangodb-driver
+DEPENDPATH += $$PWD/../../../arangodb-driver-dist/debug
+}
+else:unix:CONFIG(release, debug|release): {
+LIBS += -L$$PWD/../../../arangodb-driver-dist/release/ -larangodb-driver
+DEPENDPATH += $$PWD/../../../arangodb-driver-dist/release
+}
+
+INCLUDEPATH += $$PWD/../../src
@@ -0,0 +1,360 @@
+/********************************************************************************
+ ** The MIT License (MIT)
+ **
+ ** Copyright (c) 2013 Sascha Ludwig Häusler
+ **
+ ** Permission is hereby granted, free of charge, to any person obtaining a copy of
+ ** this software and associated documentation files (the "Software"), to deal in
+ ** the Software without restriction, including without limitation the rights to
+ ** use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ ** the Software, and to permit persons to whom the Software is furnished to do so,
+ ** subject to the following conditions:
+ **
+ ** The above copyright notice and this permission notice shall be included in all
+ ** copies or substantial portions of the Software.
+ **
+ ** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ ** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ ** FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ ** COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ ** IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ ** CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *********************************************************************************/
+
+#include <QtTest>
+#include <QtCore>
+#include <QtNetwork>
+#include <Document.h>
+#include <QBCursor.h>
+#include <QueryBuilder.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+using namespace arangodb;
+
+namespace {
+
+std::atomic<qint64> allocations(0);
+
+}
+
+// Counts every allocation of the process, the benchmarks
+// read the counter before and after their loop
+
+void * operator new(std::size_t size)
+{
+    ++allocations;
+    if ( void * p = std::malloc(size ? size : 1) ) return p;
+    throw std::bad_alloc();
+}
+
+void * operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void * p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void * p) noexcept
+{
+    std::free(p);
+}
+
+namespace {
+
+/**
+ * @brief Reports the allocations per operation of a benchmark
+ * loop. QBENCHMARK decides how often the loop runs, so the
+ * operations are counted inside the loop.
+ */
+class AllocationCounter
+{
+    public:
+        AllocationCounter() :
+            m_start(allocations.load()),
+            m_operations(0)
+        {
+        }
+
+        ~AllocationCounter() {
+            if ( m_operations == 0 ) return;
+
+            const double perOperation = double(allocations.load() - m_start) / m_operations;
+            qDebug("%s: %.1f allocations per operation",
+                   QTest::currentDataTag() ? QTest::currentDataTag() : "",
+                   perOperation);
+        }
+
+        inline void count(qint64 operations = 1) {
+            m_operations += operations;
+        }
+
+    private:
+        qint64 m_start;
+        qint64 m_operations;
+};
+
+/**
+ * @brief Reply with a canned body, used to feed the cursor
+ * without any network
+ */
+class CannedReply : public QNetworkReply
+{
+    public:
+        explicit CannedReply(const QByteArray & body, QObject * parent = 0) :
+            QNetworkReply(parent),
+            m_body(body),
+            m_position(0)
+        {
+            open(QIODevice::ReadOnly);
+        }
+
+        /**
+         * @brief Rewinds the body and emits finished
+         */
+        void deliver() {
+            m_position = 0;
+            emit finished();
+        }
+
+        void abort() Q_DECL_OVERRIDE {}
+
+        qint64 bytesAvailable() const Q_DECL_OVERRIDE {
+            return m_body.size() - m_position + QIODevice::bytesAvailable();
+        }
+
+        bool isSequential() const Q_DECL_OVERRIDE {
+            return true;
+        }
+
+    protected:
+        qint64 readData(char * data, qint64 maxSize) Q_DECL_OVERRIDE {
+            const qint64 size = qMin(maxSize, qint64(m_body.size() - m_position));
+            memcpy(data, m_body.constData() + m_position, size_t(size));
+            m_position += size;
+            return size;
+        }
+
+    private:
+        QByteArray m_body;
+        qint64 m_position;
+};
+
+QJsonObject createDocumentObject(int attributes)
+{
+    QJsonObject obj;
+    obj.insert(QStringLiteral("_id"), QStringLiteral("bench/1"));
+    obj.insert(QStringLiteral("_key"), QStringLiteral("1"));
+    obj.insert(QStringLiteral("_rev"), QStringLiteral("1"));
+
+    for (int i = 0; i < attributes; ++i) {
+        obj.insert(QStringLiteral("attribute%1").arg(i), (i % 2) ? QJsonValue(i) : QJsonValue(QStringLiteral("value")));
+    }
+
+    return obj;
+}
+
+}
+
+/**
+ * @brief Microbenchmarks of the CPU bound parts of the
+ * driver, none of them does any I/O
+ */
+class MicroBenchmark : public QObject
+{
+        Q_OBJECT
+
+    private Q_SLOTS:
+        void benchDocumentSet();
+        void benchDocumentGet();
+        void benchDocumentToJson_data();
+        void benchDocumentToJson();
+        void benchDocumentFromJson_data();
+        void benchDocumentFromJson();
+        void benchSelectToJson_data();
+        void benchSelectToJson();
+        void benchCursorDecode_data();
+        void benchCursorDecode();
+};
+
+void MicroBenchmark::benchDocumentSet()
+{
+    Document doc(QStringLiteral("bench"));
+    AllocationCounter counter;
+
+    QBENCHMARK {
+        doc.set(QStringLiteral("attribute"), 42);
+        counter.count();
+    }
+}
+
+void MicroBenchmark::benchDocumentGet()
+{
+    Document doc(createDocumentObject(20));
+    AllocationCounter counter;
+
+    QBENCHMARK {
+        doc.get(QStringLiteral("attribute7"));
+        counter.count();
+    }
+}
+
+void MicroBenchmark::benchDocumentToJson_data()
+{
+    QTest::addColumn<int>("attributes");
+    QTest::addColumn<bool>("dirtyOnly");
+
+    QTest::newRow("20 attributes, full") << 20 << false;
+    QTest::newRow("20 attributes, 1 dirty") << 20 << true;
+    QTest::newRow("200 attributes, full") << 200 << false;
+    QTest::newRow("200 attributes, 1 dirty") << 200 << true;
+}
+
+void MicroBenchmark::benchDocumentToJson()
+{
+    QFETCH(int, attributes);
+    QFETCH(bool, dirtyOnly);
+
+    if ( dirtyOnly ) {
+        // A loaded document with one changed attribute
+        Document loaded(createDocumentObject(attributes));
+        loaded.set(QStringLiteral("attribute0"), QStringLiteral("changed"));
+
+        AllocationCounter counter;
+        QBENCHMARK {
+            loaded.toJsonString();
+            counter.count();
+        }
+        return;
+    }
+
+    // A new document where every attribute is dirty
+    Document doc(QStringLiteral("bench"));
+    const QJsonObject obj = createDocumentObject(attributes);
+    for ( auto it = obj.constBegin(); it != obj.constEnd(); ++it ) {
+        if ( !it.key().startsWith(QChar('_')) ) doc.set(it.key(), it.value().toVariant());
+    }
+
+    AllocationCounter counter;
+    QBENCHMARK {
+        doc.toJsonString();
+        counter.count();
+    }
+}
+
+void MicroBenchmark::benchDocumentFromJson_data()
+{
+    QTest::addColumn<int>("attributes");
+
+    QTest::newRow("20 attributes") << 20;
+    QTest::newRow("200 attributes") << 200;
+}
+
+void MicroBenchmark::benchDocumentFromJson()
+{
+    QFETCH(int, attributes);
+
+    const QJsonObject obj = createDocumentObject(attributes);
+    AllocationCounter counter;
+
+    QBENCHMARK {
+        Document doc(obj);
+        counter.count();
+    }
+}
+
+void MicroBenchmark::benchSelectToJson_data()
+{
+    QTest::addColumn<int>("collections");
+    QTest::addColumn<bool>("prepared");
+
+    QTest::newRow("1 collection") << 1 << false;
+    QTest::newRow("1 collection, prepared") << 1 << true;
+    QTest::newRow("3 collections") << 3 << false;
+    QTest::newRow("3 collections, prepared") << 3 << true;
+}
+
+void MicroBenchmark::benchSelectToJson()
+{
+    QFETCH(int, collections);
+    QFETCH(bool, prepared);
+
+    QStringList names;
+    QHash<QString, QVariant> result;
+    for (int i = 0; i < collections; ++i) {
+        const QString name = QStringLiteral("bench%1").arg(i);
+        names.append(name);
+        result.insert(name, QStringList() << QStringLiteral("a") << QStringLiteral("b") << QStringLiteral("c"));
+    }
+
+    QueryBuilder qb;
+    auto select = qb.createSelect(names);
+    select->setWhere(QStringLiteral("a"), QStringLiteral("value"));
+    select->setResult(result);
+
+    AllocationCounter counter;
+    QBENCHMARK {
+        if ( !prepared ) {
+            select->setResult(result);
+        }
+
+        select->toJson();
+        counter.count();
+    }
+}
+
+void MicroBenchmark::benchCursorDecode_data()
+{
+    QTest::addColumn<int>("rows");
+    QTest::addColumn<bool>("columnar");
+    QTest::addColumn<bool>("recycling");
+
+    QTest::newRow("1000 rows") << 1000 << false << false;
+    QTest::newRow("1000 rows, recycling") << 1000 << false << true;
+    QTest::newRow("1000 rows, columnar") << 1000 << true << false;
+}
+
+void MicroBenchmark::benchCursorDecode()
+{
+    QFETCH(int, rows);
+    QFETCH(bool, columnar);
+    QFETCH(bool, recycling);
+
+    QJsonArray result;
+    for (int i = 0; i < rows; ++i) {
+        QJsonObject row = createDocumentObject(10);
+        row.insert(QStringLiteral("_id"), QStringLiteral("bench/%1").arg(i));
+        result.append(row);
+    }
+
+    QJsonObject body;
+    body.insert(QStringLiteral("result"), result);
+    body.insert(QStringLiteral("hasMore"), false);
+    body.insert(QStringLiteral("error"), false);
+    body.insert(QStringLiteral("code"), 201);
+
+    CannedReply reply(QJsonDocument(body).toJson(QJsonDocument::Compact));
+    QBCursor cursor;
+    cursor.setColumnar(columnar);
+    cursor.setBatchRecycling(recycling);
+
+    AllocationCounter counter;
+    QBENCHMARK {
+        // The cursor disconnects itself after every batch
+        connect(&reply, &QNetworkReply::finished,
+                &cursor, &QBCursor::_ar_cursor_result_loaded);
+        reply.deliver();
+
+        if ( !recycling ) cursor.clearData();
+        counter.count(rows);
+    }
+}
+
+QTEST_MAIN(MicroBenchmark)
+
+#include "tst_MicroBenchmark.moc"
@@ -0,0 +1,536 @@
+/********************************************************************************
+ ** The MIT License (MIT)
+ **
+ ** Copyright (c) 2013 Sascha Ludwig Häusler
+ **
+ ** Permission is hereby granted, free of charge, to any person obtaining a copy of
+ ** this software and associated documentation files (the "Software"), to deal in
+ ** the Software without restriction, including without limitation the rights to
+ ** use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ ** the Software, and to permit persons to whom the Software is furnished to do so,
+ ** subject to the following conditions:
+ **
+ ** The above copyright notice and this permission notice shall be included in all
+ ** copies or substantial portions of the Software.
+ **
+ ** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ ** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ ** FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ ** COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ ** IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ ** CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *********************************************************************************/
+
+#include "ArangoStandIn.h"
+
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QPointer>
+#include <QtCore/QRegularExpression>
+#include <QtCore/QTimer>
+#include <QtCore/QUrl>
+
+namespace {
+
+const int DocumentCollectionType = 2;
+const int EdgeCollectionType = 3;
+
+QByteArray reasonPhrase(int status)
+{
+    switch (status)
+    {
+        case 200: return QByteArrayLiteral("OK");
+        case 201: return QByteArrayLiteral("Created");
+        case 202: return QByteArrayLiteral("Accepted");
+        case 400: return QByteArrayLiteral("Bad Request");
+        case 404: return QByteArrayLiteral("Not Found");
+        case 409: return QByteArrayLiteral("Conflict");
+        default:  return QByteArrayLiteral("Unknown");
+    }
+}
+
+}
+
+ArangoStandIn::ArangoStandIn(QObject * parent) :
+    QTcpServer(parent)
+{
+    connect(this, &QTcpServer::newConnection,
+            this, &ArangoStandIn::_ar_new_connection
+            );
+}
+
+bool ArangoStandIn::start()
+{
+    return listen(QHostAddress::LocalHost, 0);
+}
+
+void ArangoStandIn::setLatency(int milliseconds)
+{
+    m_latency = qMax(milliseconds, 0);
+}
+
+int ArangoStandIn::latency() const
+{
+    return m_latency;
+}
+
+void ArangoStandIn::fillCollection(const QString & collection, int count, int payloadSize)
+{
+    if ( !m_collectionTypes.contains(collection) ) {
+        m_collectionTypes.insert(collection, DocumentCollectionType);
+    }
+
+    const QString payload(payloadSize, QChar('x'));
+    for (int i = 0; i < count; ++i) {
+        QJsonObject document;
+        document.insert(QStringLiteral("number"), i);
+        document.insert(QStringLiteral("payload"), payload);
+        createDocument(collection, document);
+    }
+}
+
+void ArangoStandIn::truncateCollection(const QString & collection)
+{
+    m_collections.remove(collection);
+}
+
+int ArangoStandIn::documentCount(const QString & collection) const
+{
+    return m_collections.value(collection).size();
+}
+
+qint64 ArangoStandIn::requestCount() const
+{
+    return m_requests;
+}
+
+void ArangoStandIn::_ar_new_connection()
+{
+    while ( hasPendingConnections() ) {
+        QTcpSocket * socket = nextPendingConnection();
+        m_buffers.insert(socket, QByteArray());
+
+        connect(socket, &QTcpSocket::readyRead,
+                this, &ArangoStandIn::_ar_ready_read
+                );
+        connect(socket, &QTcpSocket::disconnected,
+                this, &ArangoStandIn::_ar_disconnected
+                );
+    }
+}
+
+void ArangoStandIn::_ar_disconnected()
+{
+    QTcpSocket * socket = qobject_cast<QTcpSocket *>(sender());
+    m_buffers.remove(socket);
+    socket->deleteLater();
+}
+
+void ArangoStandIn::_ar_ready_read()
+{
+    QTcpSocket * socket = qobject_cast<QTcpSocket *>(sender());
+    QByteArray & buffer = m_buffers[socket];
+    buffer.append(socket->readAll());
+
+    // The network manager may send the next request on the
+    // same connection before the previous one is answered
+    forever {
+        const int headerEnd = buffer.indexOf("\r\n\r\n");
+        if ( headerEnd < 0 ) return;
+
+        const QList<QByteArray> lines = buffer.left(headerEnd).split('\n');
+        const QList<QByteArray> requestLine = lines.first().trimmed().split(' ');
+        if ( requestLine.size() < 2 ) {
+            socket->disconnectFromHost();
+            return;
+        }
+
+        int contentLength = 0;
+        for (int i = 1; i < lines.size(); ++i) {
+            const QByteArray line = lines.at(i).trimmed();
+            const int colon = line.indexOf(':');
+            if ( colon > 0 && line.left(colon).toLower() == "content-length" ) {
+                contentLength = line.mid(colon + 1).trimmed().toInt();
+            }
+        }
+
+        const int requestSize = headerEnd + 4 + contentLength;
+        if ( buffer.size() < requestSize ) return;
+
+        const QUrl url(QString::fromUtf8(requestLine.at(1)));
+
+        Request request;
+        request.method = requestLine.at(0);
+        request.path   = url.path().split(QChar('/'), QString::SkipEmptyParts);
+        request.query  = QUrlQuery(url);
+        request.body   = buffer.mid(headerEnd + 4, contentLength);
+
+        buffer.remove(0, requestSize);
+
+        send(socket, request, handle(request));
+    }
+}
+
+void ArangoStandIn::send(QTcpSocket * socket, const Request & request, const Response & response)
+{
+    ++m_requests;
+
+    const QByteArray body = (request.method == "HEAD") ? QByteArray()
+                                                       : QJsonDocument(response.body).toJson(QJsonDocument::Compact);
+
+    QByteArray data = "HTTP/1.1 " + QByteArray::number(response.status) + ' ' + reasonPhrase(response.status) + "\r\n";
+    data += "Content-Type: application/json; charset=utf-8\r\n";
+    data += "Content-Length: " + QByteArray::number(body.size()) + "\r\n";
+    data += "Connection: Keep-Alive\r\n";
+    if ( !response.etag.isEmpty() ) {
+        data += "Etag: \"" + response.etag + "\"\r\n";
+    }
+    data += "\r\n";
+    data += body;
+
+    if ( m_latency == 0 ) {
+        socket->write(data);
+        return;
+    }
+
+    // All responses have the same delay, so they stay in order
+    QPointer<QTcpSocket> guard(socket);
+    QTimer::singleShot(m_latency, this, [guard, data] {
+        if ( guard ) guard->write(data);
+    });
+}
+
+ArangoStandIn::Response ArangoStandIn::handle(const Request & request)
+{
+    if ( request.path.size() < 2 || request.path.first() != QLatin1String("_api") ) {
+        return error(404, 404, QStringLiteral("unknown path"));
+    }
+
+    const QString & api = request.path.at(1);
+
+    if ( api == QLatin1String("collection") ) return handleCollection(request);
+    if ( api == QLatin1String("document") )   return handleDocument(request, false);
+    if ( api == QLatin1String("edge") )       return handleDocument(request, true);
+    if ( api == QLatin1String("edges") )      return handleEdges(request);
+    if ( api == QLatin1String("cursor") )     return handleCursor(request);
+    if ( api == QLatin1String("import") )     return handleImport(request);
+
+    return error(404, 404, QStringLiteral("unknown path"));
+}
+
+ArangoStandIn::Response ArangoStandIn::handleCollection(const Request & request)
+{
+    if ( request.method == "POST" && request.path.size() == 2 ) {
+        const QJsonObject obj = QJsonDocument::fromJson(request.body).object();
+        const QString name = obj.value(QStringLiteral("name")).toString();
+        if ( m_collectionTypes.contains(name) ) {
+            return error(409, 1207, QStringLiteral("duplicate name"));
+        }
+
+        const int type = obj.value(QStringLiteral("type")).toInt(DocumentCollectionType);
+        m_collectionTypes.insert(name, type);
+
+        Response response;
+        response.body = collectionInfo(name, type);
+        return response;
+    }
+
+    if ( request.path.size() < 3 ) {
+        return error(400, 400, QStringLiteral("bad request"));
+    }
+
+    const QString name = request.path.at(2);
+    if ( !m_collectionTypes.contains(name) ) {
+        return error(404, 1203, QStringLiteral("collection not found"));
+    }
+
+    Response response;
+    response.body = collectionInfo(name, m_collectionTypes.value(name));
+
+    if ( request.method == "DELETE" ) {
+        m_collectionTypes.remove(name);
+        m_collections.remove(name);
+    }
+    else if ( request.method == "PUT" ) {
+        response.body.insert(QStringLiteral("count"), documentCount(name));
+    }
+
+    return response;
+}
+
+ArangoStandIn::Response ArangoStandIn::handleDocument(const Request & request, bool isEdge)
+{
+    if ( request.method == "POST" ) {
+        QJsonObject document = QJsonDocument::fromJson(request.body).object();
+        const QString collection = request.query.queryItemValue(QStringLiteral("collection"));
+
+        if ( isEdge ) {
+            if ( !m_collectionTypes.contains(collection) ) {
+                m_collectionTypes.insert(collection, EdgeCollectionType);
+            }
+            document.insert(QStringLiteral("_from"), request.query.queryItemValue(QStringLiteral("from")));
+            document.insert(QStringLiteral("_to"), request.query.queryItemValue(QStringLiteral("to")));
+        }
+
+        return createDocument(collection, document);
+    }
+
+    if ( request.path.size() < 4 ) {
+        return error(400, 400, QStringLiteral("bad request"));
+    }
+
+    const QString collection = request.path.at(2);
+    const QString key = request.path.at(3);
+
+    Collection & documents = m_collections[collection];
+    Collection::iterator it = documents.find(key);
+    if ( it == documents.end() ) {
+        return error(404, 1202, QStringLiteral("document not found"));
+    }
+
+    Response response;
+
+    if ( request.method == "GET" || request.method == "HEAD" ) {
+        response.body = it.value();
+        response.etag = it.value().value(QStringLiteral("_rev")).toString().toUtf8();
+        return response;
+    }
+
+    if ( request.method == "DELETE" ) {
+        response.status = 202;
+        response.body.insert(QStringLiteral("_id"), it.value().value(QStringLiteral("_id")));
+        response.body.insert(QStringLiteral("_key"), key);
+        response.body.insert(QStringLiteral("_rev"), it.value().value(QStringLiteral("_rev")));
+        response.body.insert(QStringLiteral("error"), false);
+        documents.erase(it);
+        return response;
+    }
+
+    // PUT replaces and PATCH merges, both keep the system attributes
+    const QJsonObject changes = QJsonDocument::fromJson(request.body).object();
+    QJsonObject document = (request.method == "PATCH") ? it.value() : QJsonObject();
+    for ( auto change = changes.constBegin(); change != changes.constEnd(); ++change ) {
+        if ( !change.key().startsWith(QChar('_')) ) document.insert(change.key(), change.value());
+    }
+
+    const QString oldRev = it.value().value(QStringLiteral("_rev")).toString();
+    for ( const QString & attribute : {QStringLiteral("_id"), QStringLiteral("_key"),
+                                       QStringLiteral("_from"), QStringLiteral("_to")} ) {
+        if ( it.value().contains(attribute) ) document.insert(attribute, it.value().value(attribute));
+    }
+    document.insert(QStringLiteral("_rev"), QString::number(m_nextId++));
+    it.value() = document;
+
+    response.status = 202;
+    response.body.insert(QStringLiteral("_id"), document.value(QStringLiteral("_id")));
+    response.body.insert(QStringLiteral("_key"), key);
+    response.body.insert(QStringLiteral("_rev"), document.value(QStringLiteral("_rev")));
+    response.body.insert(QStringLiteral("_oldRev"), oldRev);
+    response.body.insert(QStringLiteral("error"), false);
+    return response;
+}
+
+ArangoStandIn::Response ArangoStandIn::handleEdges(const Request & request)
+{
+    if ( request.path.size() < 3 ) {
+        return error(400, 400, QStringLiteral("bad request"));
+    }
+
+    const QString vertex = request.query.queryItemValue(QStringLiteral("vertex"));
+    const QString direction = request.query.queryItemValue(QStringLiteral("direction"));
+    const bool matchFrom = direction != QLatin1String("in");
+    const bool matchTo = direction != QLatin1String("out");
+
+    QJsonArray edges;
+    for ( const QJsonObject & edge : m_collections.value(request.path.at(2)) ) {
+        if ( (matchFrom && edge.value(QStringLiteral("_from")).toString() == vertex) ||
+             (matchTo && edge.value(QStringLiteral("_to")).toString() == vertex) ) {
+            edges.append(edge);
+        }
+    }
+
+    Response response;
+    response.body.insert(QStringLiteral("edges"), edges);
+    response.body.insert(QStringLiteral("error"), false);
+    response.body.insert(QStringLiteral("code"), 200);
+    return response;
+}
+
+ArangoStandIn::Response ArangoStandIn::handleCursor(const Request & request)
+{
+    if ( request.method == "PUT" && request.path.size() == 3 ) {
+        return nextBatch(request.path.at(2), 200);
+    }
+
+    if ( request.method == "DELETE" && request.path.size() == 3 ) {
+        if ( m_cursors.remove(request.path.at(2)) == 0 ) {
+            return error(404, 1600, QStringLiteral("cursor not found"));
+        }
+
+        Response response;
+        response.status = 202;
+        response.body.insert(QStringLiteral("id"), request.path.at(2));
+        response.body.insert(QStringLiteral("error"), false);
+        response.body.insert(QStringLiteral("code"), 202);
+        return response;
+    }
+
+    const QJsonObject obj = QJsonDocument::fromJson(request.body).object();
+    const QString query = obj.value(QStringLiteral("query")).toString();
+    const QJsonObject bindVars = obj.value(QStringLiteral("bindVars")).toObject();
+
+    static const QRegularExpression forExpression(QStringLiteral("FOR\\s+\\S+\\s+IN\\s+(@?@?\\w+)"));
+    const QRegularExpressionMatch match = forExpression.match(query);
+    if ( !match.hasMatch() ) {
+        return error(400, 1501, QStringLiteral("query not supported by the stand-in"));
+    }
+
+    QString collection = match.captured(1);
+    if ( collection.startsWith(QStringLiteral("@@")) ) {
+        collection = bindVars.value(collection.mid(1)).toString();
+    }
+
+    Cursor cursor;
+    cursor.documents = m_collections.value(collection).values();
+    cursor.batchSize = qMax(obj.value(QStringLiteral("batchSize")).toInt(1000), 1);
+
+    const QString id = QString::number(m_nextId++);
+    m_cursors.insert(id, cursor);
+
+    Response response = nextBatch(id, 201);
+    if ( obj.value(QStringLiteral("count")).toBool() ) {
+        response.body.insert(QStringLiteral("count"), cursor.documents.size());
+    }
+
+    return response;
+}
+
+ArangoStandIn::Response ArangoStandIn::handleImport(const Request & request)
+{
+    const QString collection = request.query.queryItemValue(QStringLiteral("collection"));
+
+    int created = 0;
+    int errors = 0;
+    QJsonArray details;
+
+    for ( const QByteArray & line : request.body.split('\n') ) {
+        if ( line.trimmed().isEmpty() ) continue;
+
+        const QJsonDocument doc = QJsonDocument::fromJson(line);
+        if ( doc.isObject() ) {
+            createDocument(collection, doc.object());
+            ++created;
+        }
+        else {
+            ++errors;
+            details.append(QStringLiteral("invalid JSON line"));
+        }
+    }
+
+    Response response;
+    response.status = 201;
+    response.body.insert(QStringLiteral("error"), false);
+    response.body.insert(QStringLiteral("created"), created);
+    response.body.insert(QStringLiteral("errors"), errors);
+    response.body.insert(QStringLiteral("empty"), 0);
+    response.body.insert(QStringLiteral("details"), details);
+    return response;
+}
+
+ArangoStandIn::Response ArangoStandIn::nextBatch(const QString & id, int status)
+{
+    QHash<QString, Cursor>::iterator it = m_cursors.find(id);
+    if ( it == m_cursors.end() ) {
+        return error(404, 1600, QStringLiteral("cursor not found"));
+    }
+
+    Cursor & cursor = it.value();
+    const int end = qMin(cursor.position + cursor.batchSize, cursor.documents.size());
+
+    QJsonArray result;
+    for (int i = cursor.position; i < end; ++i) {
+        result.append(cursor.documents.at(i));
+    }
+    cursor.position = end;
+
+    const bool hasMore = end < cursor.documents.size();
+
+    QJsonObject stats;
+    stats.insert(QStringLiteral("scannedFull"), cursor.documents.size());
+    stats.insert(QStringLiteral("scannedIndex"), 0);
+    stats.insert(QStringLiteral("filtered"), 0);
+
+    QJsonObject extra;
+    extra.insert(QStringLiteral("stats"), stats);
+
+    Response response;
+    response.status = status;
+    response.body.insert(QStringLiteral("result"), result);
+    response.body.insert(QStringLiteral("hasMore"), hasMore);
+    response.body.insert(QStringLiteral("cached"), false);
+    response.body.insert(QStringLiteral("extra"), extra);
+    response.body.insert(QStringLiteral("error"), false);
+    response.body.insert(QStringLiteral("code"), status);
+
+    if ( hasMore ) {
+        response.body.insert(QStringLiteral("id"), id);
+    }
+    else {
+        m_cursors.erase(it);
+    }
+
+    return response;
+}
+
+ArangoStandIn::Response ArangoStandIn::createDocument(const QString & collection, QJsonObject document)
+{
+    if ( !m_collectionTypes.contains(collection) ) {
+        m_collectionTypes.insert(collection, DocumentCollectionType);
+    }
+
+    QString key = document.value(QStringLiteral("_key")).toString();
+    if ( key.isEmpty() ) key = QString::number(m_nextId++);
+
+    const QString id = collection + QChar('/') + key;
+    const QString rev = QString::number(m_nextId++);
+
+    document.insert(QStringLiteral("_id"), id);
+    document.insert(QStringLiteral("_key"), key);
+    document.insert(QStringLiteral("_rev"), rev);
+
+    m_collections[collection].insert(key, document);
+
+    Response response;
+    response.status = 202;
+    response.body.insert(QStringLiteral("_id"), id);
+    response.body.insert(QStringLiteral("_key"), key);
+    response.body.insert(QStringLiteral("_rev"), rev);
+    response.body.insert(QStringLiteral("error"), false);
+    return response;
+}
+
+ArangoStandIn::Response ArangoStandIn::error(int status, int errorNum, const QString & message)
+{
+    Response response;
+    response.status = status;
+    response.body.insert(QStringLiteral("error"), true);
+    response.body.insert(QStringLiteral("code"), status);
+    response.body.insert(QStringLiteral("errorNum"), errorNum);
+    response.body.insert(QStringLiteral("errorMessage"), message);
+    return response;
+}
+
+QJsonObject ArangoStandIn::collectionInfo(const QString & name, int type)
+{
+    QJsonObject info;
+    info.insert(QStringLiteral("id"), name);
+    info.insert(QStringLiteral("name"), name);
+    info.insert(QStringLiteral("waitForSync"), false);
+    info.insert(QStringLiteral("isVolatile"), false);
+    info.insert(QStringLiteral("isSystem"), false);
+    info.insert(QStringLiteral("status"), 3);
+    info.insert(QStringLiteral("type"), type);
+    info.insert(QStringLiteral("error"), false);
+    info.insert(QStringLiteral("code"), 200);
+    return info;
+}
@@ -0,0 +1,180 @@
+/********************************************************************************
+ ** The MIT License (MIT)
+ **
+ ** Copyright (c) 2013 Sascha Ludwig Häusler
+ **
+ ** Permission is hereby granted, free of charge, to any person obtaining a copy of
+ ** this software and associated documentation files (the "Software"), to deal in
+ ** the Software without restriction, including without limitation the rights to
+ ** use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ ** the Software, and to permit persons to whom the Software is furnished to do so,
+ ** subject to the following conditions:
+ **
+ ** The above copyright notice and this permission notice shall be included in all
+ ** copies or substantial portions of the Software.
+ **
+ ** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ ** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ ** FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ ** COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ ** IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ ** CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *********************************************************************************/
+
+#ifndef ARANGOSTANDIN_H
+#define ARANGOSTANDIN_H
+
+#include <QtCore/QHash>
+#include <QtCore/QJsonObject>
+#include <QtCore/QList>
+#include <QtCore/QUrlQuery>
+#include <QtNetwork/QTcpServer>
+#include <QtNetwork/QTcpSocket>
+
+/**
+ * @brief In process stand-in for an ArangoDB server which speaks
+ * the part of the REST API used by the driver: collections,
+ * documents, edges, the edges API, cursors and the import API.
+ * All data is kept in memory. Queries are not parsed, a cursor
+ * returns every document of the first collection of the query.
+ *
+ * Every response can be delayed by a fixed latency and
+ * collections can be filled with documents carrying a
+ * payload of a given size.
+ *
+ * @since 0.6
+ */
+class ArangoStandIn : public QTcpServer
+{
+        Q_OBJECT
+    public:
+        /**
+         * @brief ArangoStandIn
+         *
+         * @param parent
+         *
+         * @since 0.6
+         */
+        explicit ArangoStandIn(QObject * parent = 0);
+
+        /**
+         * @brief Listens on a free port of the loopback interface
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        bool start();
+
+        /**
+         * @brief Delays every response by the given milliseconds
+         *
+         * @param milliseconds
+         *
+         * @since 0.6
+         */
+        void setLatency(int milliseconds);
+
+        /**
+         * @brief latency
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        int latency() const;
+
+        /**
+         * @brief Adds count documents to the collection, each
+         * with a number and a payload string of payloadSize bytes
+         *
+         * @param collection
+         * @param count
+         * @param payloadSize
+         *
+         * @since 0.6
+         */
+        void fillCollection(const QString & collection, int count, int payloadSize = 0);
+
+        /**
+         * @brief Removes all documents of the collection
+         *
+         * @param collection
+         *
+         * @since 0.6
+         */
+        void truncateCollection(const QString & collection);
+
+        /**
+         * @brief documentCount
+         *
+         * @param collection
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        int documentCount(const QString & collection) const;
+
+        /**
+         * @brief Returns the number of requests answered so far
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        qint64 requestCount() const;
+
+    private Q_SLOTS:
+        void _ar_new_connection();
+        void _ar_ready_read();
+        void _ar_disconnected();
+
+    private:
+        struct Request {
+            QByteArray method;
+            QStringList path;
+            QUrlQuery query;
+            QByteArray body;
+        };
+
+        struct Response {
+            int status = 200;
+            QJsonObject body;
+            QByteArray etag;
+        };
+
+        struct Cursor {
+            QList<QJsonObject> documents;
+            int position = 0;
+            int batchSize = 1000;
+        };
+
+        typedef QHash<QString, QJsonObject> Collection;
+
+        Response handle(const Request & request);
+        Response handleCollection(const Request & request);
+        Response handleDocument(const Request & request, bool isEdge);
+        Response handleEdges(const Request & request);
+        Response handleCursor(const Request & request);
+        Response handleImport(const Request & request);
+
+        Response nextBatch(const QString & id, int status);
+        Response createDocument(const QString & collection, QJsonObject document);
+
+        static Response error(int status, int errorNum, const QString & message);
+        static QJsonObject collectionInfo(const QString & name, int type);
+
+        void send(QTcpSocket * socket, const Request & request, const Response & response);
+
+        QHash<QString, Collection> m_collections;
+        QHash<QString, int> m_collectionTypes;
+        QHash<QString, Cursor> m_cursors;
+        QHash<QTcpSocket *, QByteArray> m_buffers;
+
+        int m_latency = 0;
+        qint64 m_nextId = 1;
+        qint64 m_requests = 0;
+};
+
+#endif // ARANGOSTANDIN_H
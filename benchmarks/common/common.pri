@@ -0,0 +1,8 @@
+# In process stand-in for the ArangoDB REST API used by the benchmarks
+
+QT += network
+
+INCLUDEPATH += $$PWD
+
+SOURCES += $$PWD/ArangoStandIn.cpp
+HEADERS += $$PWD/ArangoStandIn.h
@@ -0,0 +1,159 @@
+/********************************************************************************
+ ** The MIT License (MIT)
+ **
+ ** Copyright (c) 2013 Sascha Ludwig Häusler
+ **
+ ** Permission is hereby granted, free of charge, to any person obtaining a copy of
+ ** this software and associated documentation files (the "Software"), to deal in
+ ** the Software without restriction, including without limitation the rights to
+ ** use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ ** the Software, and to permit persons to whom the Software is furnished to do so,
+ ** subject to the following conditions:
+ **
+ ** The above copyright notice and this permission notice shall be included in all
+ ** copies or substantial portions of the Software.
+ **
+ ** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ ** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ ** FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ ** COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ ** IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ ** CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *********************************************************************************/
+
+#include "AdjacencyCache.h"
+
+namespace arangodb
+{
+
+AdjacencyList::AdjacencyList()
+{
+}
+
+void AdjacencyList::append(const QString & neighbor, const QString & edgeKey)
+{
+    m_neighbors.append(neighbor);
+    m_neighborEnds.append(m_neighbors.size());
+    m_edgeKeys.append(edgeKey);
+    m_edgeKeyEnds.append(m_edgeKeys.size());
+}
+
+QStringList AdjacencyList::neighbors() const
+{
+    QStringList list;
+    list.reserve(size());
+
+    const int total = size();
+    for (int i = 0; i < total; ++i) {
+        list.append(neighborAt(i));
+    }
+
+    return list;
+}
+
+int AdjacencyList::byteSize() const
+{
+    return int(sizeof(AdjacencyList))
+            + (m_neighbors.capacity() + m_edgeKeys.capacity()) * int(sizeof(QChar))
+            + (m_neighborEnds.capacity() + m_edgeKeyEnds.capacity()) * int(sizeof(int));
+}
+
+AdjacencyCache::AdjacencyCache(int maxBytes) :
+    m_cache(maxBytes)
+{
+}
+
+void AdjacencyCache::setMaxBytes(int maxBytes)
+{
+    const int before = m_cache.count();
+    m_cache.setMaxCost(maxBytes);
+    m_statistics.evictions += before - m_cache.count();
+}
+
+int AdjacencyCache::maxBytes() const
+{
+    return m_cache.maxCost();
+}
+
+bool AdjacencyCache::lookup(const QString & vertexId, const QString & edgeCollection,
+                            QBTraversal::Direction direction, AdjacencyList * list)
+{
+    // QCache::object marks the vertex as recently used
+    VertexEntry * entry = m_cache.object(vertexId);
+    if ( entry ) {
+        QHash<QString, AdjacencyList>::const_iterator it = entry->lists.constFind(listKey(edgeCollection, direction));
+        if ( it != entry->lists.constEnd() ) {
+            *list = it.value();
+            ++m_statistics.hits;
+            return true;
+        }
+    }
+
+    ++m_statistics.misses;
+    return false;
+}
+
+void AdjacencyCache::insert(const QString & vertexId, const QString & edgeCollection,
+                            QBTraversal::Direction direction, const AdjacencyList & list)
+{
+    // The cost of an entry can only be changed by inserting it again
+    VertexEntry * entry = m_cache.take(vertexId);
+    if ( !entry ) {
+        entry = new VertexEntry;
+    }
+
+    const QString key = listKey(edgeCollection, direction);
+    QHash<QString, AdjacencyList>::const_iterator existing = entry->lists.constFind(key);
+    if ( existing != entry->lists.constEnd() ) {
+        entry->bytes -= existing.value().byteSize();
+    }
+
+    entry->lists.insert(key, list);
+    entry->bytes += list.byteSize();
+
+    const int before = m_cache.count();
+    m_cache.insert(vertexId, entry, entry->bytes);
+    // An entry larger than the whole cache is dropped right away
+    m_statistics.evictions += before + 1 - m_cache.count();
+}
+
+void AdjacencyCache::invalidate(const QString & vertexId)
+{
+    if ( m_cache.remove(vertexId) ) {
+        ++m_statistics.invalidations;
+    }
+}
+
+void AdjacencyCache::trim(int bytes)
+{
+    const int maxBytes = m_cache.maxCost();
+    if ( bytes >= maxBytes ) {
+        return;
+    }
+
+    setMaxBytes(qMax(bytes, 0));
+    m_cache.setMaxCost(maxBytes);
+}
+
+void AdjacencyCache::clear()
+{
+    m_statistics.invalidations += m_cache.count();
+    m_cache.clear();
+}
+
+AdjacencyCache::Statistics AdjacencyCache::statistics() const
+{
+    Statistics statistics = m_statistics;
+    statistics.vertices = m_cache.count();
+    statistics.bytes = m_cache.totalCost();
+    statistics.maxBytes = m_cache.maxCost();
+
+    return statistics;
+}
+
+void AdjacencyCache::resetStatistics()
+{
+    m_statistics = Statistics();
+}
+
+}
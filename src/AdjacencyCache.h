@@ -0,0 +1,301 @@
+/********************************************************************************
+ ** The MIT License (MIT)
+ **
+ ** Copyright (c) 2013 Sascha Ludwig Häusler
+ **
+ ** Permission is hereby granted, free of charge, to any person obtaining a copy of
+ ** this software and associated documentation files (the "Software"), to deal in
+ ** the Software without restriction, including without limitation the rights to
+ ** use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ ** the Software, and to permit persons to whom the Software is furnished to do so,
+ ** subject to the following conditions:
+ **
+ ** The above copyright notice and this permission notice shall be included in all
+ ** copies or substantial portions of the Software.
+ **
+ ** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ ** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ ** FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ ** COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ ** IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ ** CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *********************************************************************************/
+
+#ifndef ADJACENCYCACHE_H
+#define ADJACENCYCACHE_H
+
+#include "arangodb-driver_global.h"
+#include "QBTraversal.h"
+
+#include <QtCore/QCache>
+#include <QtCore/QHash>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+#include <QtCore/QVector>
+
+namespace arangodb
+{
+
+/**
+ * @brief The neighbors of one vertex in one edge collection and
+ * direction. The ids of the neighbors and the keys of the edges
+ * are each stored in one string with an array of end offsets,
+ * so a list needs four allocations regardless of its length.
+ *
+ * @since 0.6
+ */
+class ARANGODBDRIVERSHARED_EXPORT AdjacencyList
+{
+    public:
+        /**
+         * @brief AdjacencyList
+         *
+         * @since 0.6
+         */
+        AdjacencyList();
+
+        /**
+         * @brief append
+         *
+         * @param neighbor      Document id of the neighbor
+         * @param edgeKey       Key of the edge leading to it
+         *
+         * @since 0.6
+         */
+        void append(const QString & neighbor, const QString & edgeKey);
+
+        /**
+         * @brief size
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        inline int size() const {
+            return m_neighborEnds.size();
+        }
+
+        /**
+         * @brief isEmpty
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        inline bool isEmpty() const {
+            return m_neighborEnds.isEmpty();
+        }
+
+        /**
+         * @brief neighborAt
+         *
+         * @param i
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        inline QString neighborAt(int i) const {
+            const int start = (i == 0) ? 0 : m_neighborEnds.at(i - 1);
+            return m_neighbors.mid(start, m_neighborEnds.at(i) - start);
+        }
+
+        /**
+         * @brief edgeKeyAt
+         *
+         * @param i
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        inline QString edgeKeyAt(int i) const {
+            const int start = (i == 0) ? 0 : m_edgeKeyEnds.at(i - 1);
+            return m_edgeKeys.mid(start, m_edgeKeyEnds.at(i) - start);
+        }
+
+        /**
+         * @brief Returns the ids of all neighbors
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        QStringList neighbors() const;
+
+        /**
+         * @brief Returns the memory used by the list in bytes
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        int byteSize() const;
+
+    private:
+        QString m_neighbors;
+        QString m_edgeKeys;
+        QVector<int> m_neighborEnds;
+        QVector<int> m_edgeKeyEnds;
+};
+
+/**
+ * @brief Least recently used cache of adjacency lists keyed by
+ * vertex id. All lists of a vertex are kept in one entry, so
+ * saving or dropping an edge only has to remove the entries
+ * of its two vertices.
+ *
+ * @since 0.6
+ */
+class ARANGODBDRIVERSHARED_EXPORT AdjacencyCache
+{
+    public:
+        /**
+         * @brief Counters of the cache
+         *
+         * @since 0.6
+         */
+        struct Statistics {
+                qint64 hits = 0;
+                qint64 misses = 0;
+                qint64 evictions = 0;
+                qint64 invalidations = 0;
+
+                /**
+                 * @brief number of cached vertices
+                 *
+                 * @since 0.6
+                 */
+                int vertices = 0;
+
+                /**
+                 * @brief memory used by all lists in bytes
+                 *
+                 * @since 0.6
+                 */
+                int bytes = 0;
+
+                /**
+                 * @brief memory limit in bytes
+                 *
+                 * @since 0.6
+                 */
+                int maxBytes = 0;
+        };
+
+        /**
+         * @brief AdjacencyCache
+         *
+         * @param maxBytes
+         *
+         * @since 0.6
+         */
+        explicit AdjacencyCache(int maxBytes = 16 * 1024 * 1024);
+
+        /**
+         * @brief Sets the memory limit, the least recently used
+         * vertices are evicted until the cache fits
+         *
+         * @param maxBytes
+         *
+         * @since 0.6
+         */
+        void setMaxBytes(int maxBytes);
+
+        /**
+         * @brief maxBytes
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        int maxBytes() const;
+
+        /**
+         * @brief Looks up the list and counts a hit or a miss
+         *
+         * @param vertexId
+         * @param edgeCollection
+         * @param direction
+         * @param list
+         *
+         * @return true if the list is cached
+         *
+         * @since 0.6
+         */
+        bool lookup(const QString & vertexId, const QString & edgeCollection,
+                    QBTraversal::Direction direction, AdjacencyList * list);
+
+        /**
+         * @brief insert
+         *
+         * @param vertexId
+         * @param edgeCollection
+         * @param direction
+         * @param list
+         *
+         * @since 0.6
+         */
+        void insert(const QString & vertexId, const QString & edgeCollection,
+                    QBTraversal::Direction direction, const AdjacencyList & list);
+
+        /**
+         * @brief Removes all lists of the vertex
+         *
+         * @param vertexId
+         *
+         * @since 0.6
+         */
+        void invalidate(const QString & vertexId);
+
+        /**
+         * @brief Evicts the least recently used vertices until
+         * the cache uses at most the given bytes, the memory
+         * limit stays the same
+         *
+         * @param bytes
+         *
+         * @since 0.6
+         */
+        void trim(int bytes);
+
+        /**
+         * @brief clear
+         *
+         * @since 0.6
+         */
+        void clear();
+
+        /**
+         * @brief statistics
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        Statistics statistics() const;
+
+        /**
+         * @brief Sets all counters back to 0
+         *
+         * @since 0.6
+         */
+        void resetStatistics();
+
+    private:
+        struct VertexEntry {
+            QHash<QString, AdjacencyList> lists;
+            int bytes = 0;
+        };
+
+        static inline QString listKey(const QString & edgeCollection, QBTraversal::Direction direction) {
+            return edgeCollection + QChar(':') + QString::number(int(direction));
+        }
+
+        QCache<QString, VertexEntry> m_cache;
+        Statistics m_statistics;
+};
+
+}
+
+#endif // ADJACENCYCACHE_H
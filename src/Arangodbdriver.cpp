@@ -22,11 +22,22 @@
  *********************************************************************************/
 
 #include "Arangodbdriver.h"
+#include "private/Document_p.h"
+#include "private/JsonDecoder_p.h"
+#include "private/MemoryAccounting_p.h"
 
 #include <QtCore/QBuffer>
 #include <QtCore/QCoreApplication>
 #include <QtCore/QDebug>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QHash>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QPointer>
+#include <QtCore/QThreadPool>
+#include <QtCore/QTimer>
 #include <QtCore/QUrl>
+#include <QtCore/QUrlQuery>
 #include <QtNetwork/QNetworkAccessManager>
 #include <QtNetwork/QNetworkReply>
 
@@ -52,6 +63,47 @@ class ArangodbdriverPrivate
         int waitingListSize = 0;
         bool isWaitingListRunning;
 
+        struct CursorEntry {
+            QElapsedTimer timer;
+            int loggedBatches = 0;
+
+            QString fingerprint;
+            QVariantMap bindVars;
+
+            QPointer<QNetworkReply> firstReply;
+            bool isDisposed = false;
+        };
+
+        QHash<QBCursor *, CursorEntry> openCursors;
+
+        bool isAdjacencyCacheEnabled = false;
+        AdjacencyCache adjacencyCache;
+
+        DriverStatistics statistics;
+        QueryLog queryLog;
+
+        std::function<void(const RequestTrace &)> traceCallback;
+        QElapsedTimer traceClock;
+        quint64 lastRequestId = 0;
+
+        int backgroundDecodeThreshold = 1024 * 1024;
+        QThreadPool * decodeThreadPool = nullptr;
+
+        qint64 requestBufferBytes = 0;
+        qint64 memorySoftLimit = 0;
+        bool isOverMemoryLimit = false;
+
+        /**
+         * @brief State of one tracked request
+         */
+        struct TrackedRequest {
+            QElapsedTimer timer;
+            RequestTrace trace;
+            qint64 bufferedBytes = 0;
+
+            qint64 elapsed() const { return timer.nsecsElapsed() / 1000; }
+        };
+
         void createStandardUrl() {
             standardUrl = protocol + QString("://") + host + QString(":") + QString::number(port) + QString("/_api");
         }
@@ -67,10 +119,21 @@ Arangodbdriver::Arangodbdriver(QString protocol, QString host, qint32 port) :
     d->port = port;
 
     d->createStandardUrl();
+    d->traceClock.start();
 }
 
 Arangodbdriver::~Arangodbdriver()
 {
+    // Running replies are aborted while the network manager is
+    // deleted, their statistics must not reach the deleted data
+    for ( QNetworkReply * reply : d->networkManager.findChildren<QNetworkReply *>() ) {
+        reply->disconnect(this);
+    }
+
+    if ( d->memorySoftLimit > 0 ) {
+        internal::MemoryAccounting::softLimits.fetchAndAddRelaxed(-1);
+    }
+
     delete d;
 }
 
@@ -78,6 +141,7 @@ bool Arangodbdriver::isColllectionExisting(const QString & collectionName)
 {
     QUrl url(d->standardUrl + QString("/collection/") + collectionName);
     QNetworkReply *reply = d->networkManager.get(QNetworkRequest(url));
+    track(reply, DriverStatistics::Operation::CollectionGet, 0);
 
     bool isWaiting = true;
 
@@ -106,6 +170,8 @@ Collection *Arangodbdriver::getCollection(QString name)
             collection, &Collection::_ar_dataIsAvailable
             );
 
+    track(reply, DriverStatistics::Operation::CollectionGet, 0);
+
     connectCollection(collection);
 
     return collection;
@@ -150,6 +216,8 @@ Document *Arangodbdriver::getDocument(QString id)
             doc, &Document::_ar_dataIsAvailable
             );
 
+    track(reply, DriverStatistics::Operation::DocumentGet, 0);
+
     connectDocument(doc);
 
     return doc;
@@ -201,6 +269,8 @@ Edge *Arangodbdriver::getEdge(QString id)
             e, &Document::_ar_dataIsAvailable
             );
 
+    track(reply, DriverStatistics::Operation::EdgeGet, 0);
+
     connect(e, &Edge::saveData,
             this, &Arangodbdriver::_ar_edge_save
             );
@@ -243,22 +313,231 @@ Edge *Arangodbdriver::createEdge(QString collection, Document *fromDoc, Document
     return e;
 }
 
+EdgeImport * Arangodbdriver::createEdgeImport(const QString & collection, int chunkSize)
+{
+    EdgeImport * import = new EdgeImport(collection, chunkSize, this);
+    import->setCollectingVertices(d->isAdjacencyCacheEnabled);
+
+    connect(import, &EdgeImport::sendChunk,
+            this, &Arangodbdriver::_ar_edge_import
+            );
+
+    return import;
+}
+
 QSharedPointer<QBCursor> Arangodbdriver::executeSelect(QSharedPointer<QBSelect> select)
 {
-    QSharedPointer<QBCursor> cursor(new QBCursor(this));
+    QSharedPointer<QBCursor> cursor = createCursor();
+    cursor->setColumnar(select->isColumnar());
+
+    auto & entry = d->openCursors[cursor.data()];
+    entry.fingerprint = QueryLog::fingerprint(select->query());
+    entry.bindVars = select->bindVars();
+
+    postCursorRequest(cursor.data(), QString("/cursor"), select->toJson());
+
+    return cursor;
+}
+
+QSharedPointer<QBCursor> Arangodbdriver::executeQuery(const QString & query, const QVariantMap & bindVars)
+{
+    QSharedPointer<QBCursor> cursor = createCursor();
+
+    auto & entry = d->openCursors[cursor.data()];
+    entry.fingerprint = QueryLog::fingerprint(query);
+    entry.bindVars = bindVars;
+
+    QJsonObject body;
+    body.insert(QStringLiteral("query"), query);
+    body.insert(QStringLiteral("bindVars"), QJsonObject::fromVariantMap(bindVars));
+
+    postCursorRequest(cursor.data(), QString("/cursor"), QJsonDocument(body).toJson(QJsonDocument::Compact));
+
+    return cursor;
+}
+
+QSharedPointer<QBCursor> Arangodbdriver::executeTraversal(QSharedPointer<QBTraversal> traversal)
+{
+    QSharedPointer<QBCursor> cursor = createCursor();
+
+    auto & entry = d->openCursors[cursor.data()];
+    entry.fingerprint = QueryLog::fingerprint(traversal->query());
+    entry.bindVars = traversal->bindVars();
+
+    postCursorRequest(cursor.data(), QString("/cursor"), traversal->toJson());
+
+    return cursor;
+}
+
+QSharedPointer<QBCursor> Arangodbdriver::getEdges(const QString & edgeCollection,
+                                                  const QString & vertexId,
+                                                  QBTraversal::Direction direction)
+{
+    QSharedPointer<QBCursor> cursor = createCursor();
 
-    QByteArray jsonSelect = select->toJson();
-    QUrl url(d->standardUrl + QString("/cursor"));
+    QUrlQuery query;
+    query.addQueryItem(QStringLiteral("vertex"), vertexId);
+    if ( direction == QBTraversal::Direction::Outbound ) {
+        query.addQueryItem(QStringLiteral("direction"), QStringLiteral("out"));
+    }
+    else if ( direction == QBTraversal::Direction::Inbound ) {
+        query.addQueryItem(QStringLiteral("direction"), QStringLiteral("in"));
+    }
+
+    QUrl url(d->standardUrl + QString("/edges/") + edgeCollection);
+    url.setQuery(query);
     QNetworkRequest request(url);
-    request.setRawHeader("Content-Type", "application/json");
-    request.setRawHeader("Content-Length", QByteArray::number(jsonSelect.size()));
 
-    QNetworkReply *reply = d->networkManager.post(request, jsonSelect);
+    QNetworkReply *reply = d->networkManager.get(request);
 
     connect(reply, &QNetworkReply::finished,
             cursor.data(), &QBCursor::_ar_cursor_result_loaded
             );
 
+    track(reply, DriverStatistics::Operation::EdgesLookup, 0);
+
+    return cursor;
+}
+
+AdjacencyList Arangodbdriver::adjacency(const QString & edgeCollection,
+                                        const QString & vertexId,
+                                        QBTraversal::Direction direction)
+{
+    AdjacencyList result;
+    bool isLoaded = false;
+
+    loadAdjacency(edgeCollection, vertexId, direction,
+                  [&result, &isLoaded](const AdjacencyList & list, const QString &) {
+        result = list;
+        isLoaded = true;
+    });
+
+    while (!isLoaded) {
+        qApp->processEvents();
+    }
+
+    return result;
+}
+
+void Arangodbdriver::loadAdjacency(const QString & edgeCollection,
+                                   const QString & vertexId,
+                                   QBTraversal::Direction direction,
+                                   AdjacencyCallback callback)
+{
+    AdjacencyList cached;
+
+    if ( d->isAdjacencyCacheEnabled &&
+         d->adjacencyCache.lookup(vertexId, edgeCollection, direction, &cached) ) {
+        callback(cached, QString());
+        return;
+    }
+
+    QSharedPointer<QBCursor> cursor = getEdges(edgeCollection, vertexId, direction);
+    auto connections = std::make_shared<QList<QMetaObject::Connection>>();
+
+    auto loaded = [this, cursor, connections, edgeCollection, vertexId, direction, callback] {
+        for ( const QMetaObject::Connection & connection : *connections ) {
+            disconnect(connection);
+        }
+
+        AdjacencyList list;
+
+        if ( !cursor->hasErrorOccurred() ) {
+            for ( Document * edge : cursor->data() ) {
+                const QString from = edge->get(internal::FROM).toString();
+                const QString to = edge->get(internal::TO).toString();
+
+                // Loops lead back to the vertex itself in both directions
+                const QString neighbor = (direction == QBTraversal::Direction::Inbound || to == vertexId) ? from : to;
+                list.append(neighbor, edge->key());
+            }
+
+            // Only the list is kept, the documents are owned by the caller
+            cursor->clearData();
+
+            if ( d->isAdjacencyCacheEnabled ) {
+                d->adjacencyCache.insert(vertexId, edgeCollection, direction, list);
+            }
+        }
+
+        callback(list, cursor->errorMessage());
+
+        // The cursor is still emitting, it is released afterwards
+        QTimer::singleShot(0, this, [cursor] {});
+    };
+
+    connections->append(connect(cursor.data(), &QBCursor::ready, this, loaded));
+    connections->append(connect(cursor.data(), &QBCursor::error, this, loaded));
+}
+
+void Arangodbdriver::setAdjacencyCacheEnabled(bool enabled)
+{
+    d->isAdjacencyCacheEnabled = enabled;
+    if ( !enabled ) {
+        d->adjacencyCache.clear();
+    }
+}
+
+bool Arangodbdriver::isAdjacencyCacheEnabled() const
+{
+    return d->isAdjacencyCacheEnabled;
+}
+
+void Arangodbdriver::setAdjacencyCacheLimit(int bytes)
+{
+    d->adjacencyCache.setMaxBytes(bytes);
+}
+
+AdjacencyCache::Statistics Arangodbdriver::adjacencyCacheStatistics() const
+{
+    return d->adjacencyCache.statistics();
+}
+
+QSharedPointer<QBExplain> Arangodbdriver::explain(QSharedPointer<QBSelect> select)
+{
+    QSharedPointer<QBExplain> explain(new QBExplain(this));
+
+    QJsonObject obj;
+    obj.insert(QStringLiteral("query"), select->query());
+    if ( !select->bindVars().isEmpty() ) {
+        obj.insert(QStringLiteral("bindVars"), QJsonObject::fromVariantMap(select->bindVars()));
+    }
+
+    QByteArray body = QJsonDocument(obj).toJson(QJsonDocument::Compact);
+
+    QUrl url(d->standardUrl + QString("/explain"));
+    QNetworkRequest request(url);
+    request.setRawHeader("Content-Type", "application/json");
+    request.setRawHeader("Content-Length", QByteArray::number(body.size()));
+
+    QNetworkReply *reply = d->networkManager.post(request, body);
+
+    connect(reply, &QNetworkReply::finished,
+            explain.data(), &QBExplain::_ar_explain_loaded
+            );
+
+    track(reply, DriverStatistics::Operation::Explain, body.size());
+
+    return explain;
+}
+
+QSharedPointer<QBCursor> Arangodbdriver::exportCollection(const QString & collectionName,
+                                                          const Collection::ExportOptions & options,
+                                                          QIODevice * device)
+{
+    QSharedPointer<QBCursor> cursor = createCursor();
+    cursor->setOutputDevice(device);
+
+    QJsonDocument doc;
+    doc.setObject(options.object());
+
+    QUrlQuery query;
+    query.addQueryItem(QStringLiteral("collection"), collectionName);
+
+    postCursorRequest(cursor.data(),
+                      QString("/export?") + query.toString(QUrl::FullyEncoded),
+                      doc.toJson(QJsonDocument::Compact));
+
     return cursor;
 }
 
@@ -273,6 +552,332 @@ void Arangodbdriver::loadMoreResults(QBCursor * cursor)
     connect(reply, &QNetworkReply::finished,
             cursor, &QBCursor::_ar_cursor_result_loaded
             );
+
+    track(reply, DriverStatistics::Operation::CursorNext, 0);
+}
+
+void Arangodbdriver::disposeCursor(QBCursor * cursor)
+{
+    auto it = d->openCursors.find(cursor);
+    if ( it == d->openCursors.end() ) {
+        return;
+    }
+
+    // The id only comes with the first batch,
+    // _ar_cursor_updated releases the cursor then
+    if ( cursor->id().isEmpty() ) {
+        it.value().isDisposed = true;
+        return;
+    }
+
+    d->openCursors.erase(it);
+
+    // Exhausted cursors are already released by the server
+    if ( cursor->hasMore() ) {
+        deleteServerCursor(cursor->id());
+    }
+}
+
+void Arangodbdriver::abandonCursor(QBCursor * cursor, internal::JsonDecoder * decoder)
+{
+    auto it = d->openCursors.find(cursor);
+    if ( it == d->openCursors.end() ) {
+        return;
+    }
+
+    const bool isFirstBatchPending = cursor->id().isEmpty();
+    QNetworkReply * reply = it.value().firstReply;
+    d->openCursors.erase(it);
+
+    if ( !isFirstBatchPending ) {
+        if ( cursor->hasMore() ) {
+            deleteServerCursor(cursor->id());
+        }
+        return;
+    }
+
+    if ( decoder ) {
+        decoder->setParent(this);
+        decoder->setCallback([this](const QJsonDocument & document) {
+            releaseCursorBatch(document.object());
+        });
+    }
+    else if ( reply && reply->isRunning() ) {
+        disconnect(reply, &QNetworkReply::finished,
+                   cursor, &QBCursor::_ar_cursor_result_loaded);
+        connect(reply, &QNetworkReply::finished, this, [this, reply] {
+            releaseCursorBatch(QJsonDocument::fromJson(reply->readAll()).object());
+            reply->deleteLater();
+        });
+    }
+}
+
+void Arangodbdriver::releaseCursorBatch(const QJsonObject & batch)
+{
+    if ( batch.value(QStringLiteral("hasMore")).toBool() ) {
+        deleteServerCursor(batch.value(QStringLiteral("id")).toString());
+    }
+}
+
+void Arangodbdriver::invalidateAdjacency(QNetworkReply * reply, const QStringList & vertices)
+{
+    for ( const QString & vertex : vertices ) {
+        d->adjacencyCache.invalidate(vertex);
+    }
+
+    connect(reply, &QNetworkReply::finished, this, [this, vertices] {
+        for ( const QString & vertex : vertices ) {
+            d->adjacencyCache.invalidate(vertex);
+        }
+    });
+}
+
+void Arangodbdriver::deleteServerCursor(const QString & id)
+{
+    if ( id.isEmpty() ) {
+        return;
+    }
+
+    QUrl url(d->standardUrl + QString("/cursor/") + id);
+    QNetworkReply *reply = d->networkManager.deleteResource(QNetworkRequest(url));
+
+    connect(reply, &QNetworkReply::finished,
+            reply, &QNetworkReply::deleteLater
+            );
+
+    track(reply, DriverStatistics::Operation::CursorDelete, 0);
+}
+
+int Arangodbdriver::openCursorCount() const
+{
+    return d->openCursors.size();
+}
+
+QList<Arangodbdriver::CursorInfo> Arangodbdriver::openCursors() const
+{
+    QList<CursorInfo> cursors;
+
+    for ( auto it = d->openCursors.constBegin(); it != d->openCursors.constEnd(); ++it ) {
+        CursorInfo info;
+        info.id = it.key()->id();
+        info.age = it.value().timer.elapsed();
+        // Counted by the cursor, it does not signal every batch
+        info.loadedBatches = it.key()->batchStatistics().size();
+        cursors.append(info);
+    }
+
+    return cursors;
+}
+
+DriverStatistics Arangodbdriver::statistics() const
+{
+    return d->statistics;
+}
+
+void Arangodbdriver::resetStatistics()
+{
+    d->statistics.reset();
+}
+
+void Arangodbdriver::setBackgroundDecodeThreshold(int bytes)
+{
+    d->backgroundDecodeThreshold = bytes;
+}
+
+int Arangodbdriver::backgroundDecodeThreshold() const
+{
+    return d->backgroundDecodeThreshold;
+}
+
+void Arangodbdriver::setDecodeThreadPool(QThreadPool * pool)
+{
+    d->decodeThreadPool = pool;
+}
+
+QThreadPool * Arangodbdriver::decodeThreadPool() const
+{
+    return (d->decodeThreadPool == nullptr) ? QThreadPool::globalInstance() : d->decodeThreadPool;
+}
+
+MemoryUsage Arangodbdriver::memoryUsage() const
+{
+    MemoryUsage usage;
+    usage.documents = internal::MemoryAccounting::documentBytes.load();
+    usage.documentCount = internal::MemoryAccounting::documentCount.load();
+    usage.cursorBatches = internal::MemoryAccounting::cursorBytes.load();
+    usage.requestBuffers = d->requestBufferBytes;
+    usage.caches = d->adjacencyCache.statistics().bytes;
+
+    return usage;
+}
+
+void Arangodbdriver::setMemorySoftLimit(qint64 bytes)
+{
+    const bool hadLimit = d->memorySoftLimit > 0;
+    d->memorySoftLimit = qMax(bytes, qint64(0));
+
+    if ( hadLimit != (d->memorySoftLimit > 0) ) {
+        internal::MemoryAccounting::softLimits.fetchAndAddRelaxed(hadLimit ? -1 : 1);
+    }
+
+    d->isOverMemoryLimit = false;
+    checkMemoryLimit();
+}
+
+qint64 Arangodbdriver::memorySoftLimit() const
+{
+    return d->memorySoftLimit;
+}
+
+bool Arangodbdriver::isOverMemoryLimit() const
+{
+    return d->memorySoftLimit > 0 && memoryUsage().total() > d->memorySoftLimit;
+}
+
+void Arangodbdriver::checkMemoryLimit()
+{
+    if ( d->memorySoftLimit == 0 ) {
+        return;
+    }
+
+    MemoryUsage usage = memoryUsage();
+
+    // The cache is the only memory the driver can free by itself
+    if ( usage.total() > d->memorySoftLimit && usage.caches > 0 ) {
+        const qint64 excess = usage.total() - d->memorySoftLimit;
+        d->adjacencyCache.trim(int(qMax(usage.caches - excess, qint64(0))));
+        usage = memoryUsage();
+    }
+
+    // Only emitted once each time the limit is crossed
+    const bool isOverLimit = usage.total() > d->memorySoftLimit;
+    if ( isOverLimit && !d->isOverMemoryLimit ) {
+        Q_EMIT memoryLimitExceeded(usage.total(), d->memorySoftLimit);
+    }
+    d->isOverMemoryLimit = isOverLimit;
+}
+
+void Arangodbdriver::setSlowQueryThreshold(int milliseconds)
+{
+    d->queryLog.setThreshold(milliseconds);
+}
+
+int Arangodbdriver::slowQueryThreshold() const
+{
+    return d->queryLog.threshold();
+}
+
+QList<QueryLog::QueryStatistics> Arangodbdriver::queryStatistics() const
+{
+    return d->queryLog.queries();
+}
+
+void Arangodbdriver::resetQueryStatistics()
+{
+    d->queryLog.clear();
+}
+
+void Arangodbdriver::setTraceCallback(std::function<void(const RequestTrace &)> callback)
+{
+    d->traceCallback = std::move(callback);
+}
+
+void Arangodbdriver::track(QNetworkReply * reply, DriverStatistics::Operation operation, qint64 bytesSent)
+{
+    d->statistics.recordRequest(operation, bytesSent);
+
+    auto request = std::make_shared<internal::ArangodbdriverPrivate::TrackedRequest>();
+    request->timer.start();
+    request->trace.id = ++d->lastRequestId;
+    request->trace.operation = operation;
+    request->trace.bytesSent = bytesSent;
+    request->trace.started = d->traceClock.nsecsElapsed() / 1000;
+    request->bufferedBytes = bytesSent;
+    d->requestBufferBytes += bytesSent;
+
+    // The phases in between are only of interest for the
+    // trace, the connections are skipped without a callback
+    if ( d->traceCallback ) {
+        request->trace.url = reply->url().path();
+
+#ifndef QT_NO_SSL
+        connect(reply, &QNetworkReply::encrypted, this, [request] {
+            request->trace.encrypted = request->elapsed();
+        });
+#endif
+        connect(reply, &QNetworkReply::uploadProgress, this, [request](qint64 sent, qint64 total) {
+            if ( total > 0 && sent == total ) request->trace.sent = request->elapsed();
+        });
+        connect(reply, &QNetworkReply::metaDataChanged, this, [request] {
+            if ( request->trace.firstByte < 0 ) request->trace.firstByte = request->elapsed();
+        });
+    }
+
+    connect(reply, &QNetworkReply::downloadProgress, this, [this, request](qint64 received, qint64) {
+        const qint64 buffered = request->trace.bytesSent + received;
+        d->requestBufferBytes += buffered - request->bufferedBytes;
+        request->bufferedBytes = buffered;
+    });
+
+    // Emitted right before finished, while the whole
+    // body is still waiting to be read by the consumer
+    connect(reply, &QNetworkReply::readChannelFinished, this, [reply, request] {
+        request->trace.bytesReceived = reply->bytesAvailable();
+        request->trace.transferred = request->elapsed();
+    });
+
+    // Connected after the consumer, so the body has been read
+    // by now. QBCursor hands big batches to the thread pool, for
+    // them decoded only marks the hand-off, not the parsed batch
+    connect(reply, &QNetworkReply::finished, this, [this, reply, request] {
+        RequestTrace & trace = request->trace;
+        trace.statusCode = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+        if ( trace.transferred < 0 ) trace.transferred = request->elapsed();
+
+        d->statistics.recordReply(trace.operation, trace.statusCode, trace.bytesReceived, trace.transferred);
+
+        if ( d->traceCallback ) {
+            trace.decoded = request->elapsed();
+            d->traceCallback(trace);
+        }
+
+        d->requestBufferBytes -= request->bufferedBytes;
+        request->bufferedBytes = 0;
+        checkMemoryLimit();
+    });
+}
+
+QSharedPointer<QBCursor> Arangodbdriver::createCursor()
+{
+    QSharedPointer<QBCursor> cursor(new QBCursor(this));
+
+    d->openCursors[cursor.data()].timer.start();
+    connect(cursor.data(), &QBCursor::ready,
+            this, &Arangodbdriver::_ar_cursor_updated
+            );
+    connect(cursor.data(), &QBCursor::error,
+            this, &Arangodbdriver::_ar_cursor_updated
+            );
+
+    return cursor;
+}
+
+void Arangodbdriver::postCursorRequest(QBCursor * cursor, const QString & path, const QByteArray & body)
+{
+    QUrl url(d->standardUrl + path);
+    QNetworkRequest request(url);
+    request.setRawHeader("Content-Type", "application/json");
+    request.setRawHeader("Content-Length", QByteArray::number(body.size()));
+
+    QNetworkReply *reply = d->networkManager.post(request, body);
+
+    connect(reply, &QNetworkReply::finished,
+            cursor, &QBCursor::_ar_cursor_result_loaded
+            );
+
+    d->openCursors[cursor].firstReply = reply;
+
+    track(reply, DriverStatistics::Operation::CursorCreate, body.size());
 }
 
 void Arangodbdriver::waitUntilFinished()
@@ -340,6 +945,7 @@ void Arangodbdriver::_ar_document_save(Document *doc)
         request.setRawHeader("Content-Length", jsonDataSize);
 
         QNetworkReply *reply = Q_NULLPTR;
+        DriverStatistics::Operation operation = DriverStatistics::Operation::DocumentReplace;
 
         if ( doc->isEveryAttributeDirty() ) {
             reply = d->networkManager.put(request, d->jsonData);
@@ -347,11 +953,14 @@ void Arangodbdriver::_ar_document_save(Document *doc)
         else {
             d->data.setBuffer(&d->jsonData);
             reply = d->networkManager.sendCustomRequest(request, QByteArrayLiteral("PATCH"), &d->data);
+            operation = DriverStatistics::Operation::DocumentPatch;
         }
 
         connect(reply, &QNetworkReply::finished,
                 doc, &Document::_ar_dataIsAvailable
                 );
+
+        track(reply, operation, d->jsonData.size());
     }
     else {
         QUrl url(d->standardUrl + QString("/document?collection=") + doc->collection());
@@ -364,6 +973,8 @@ void Arangodbdriver::_ar_document_save(Document *doc)
         connect(reply, &QNetworkReply::finished,
                 doc, &Document::_ar_dataIsAvailable
                 );
+
+        track(reply, DriverStatistics::Operation::DocumentCreate, d->jsonData.size());
     }
 }
 
@@ -376,6 +987,8 @@ void Arangodbdriver::_ar_document_delete(Document *doc)
     connect(reply, &QNetworkReply::finished,
             doc, &Document::_ar_dataDeleted
             );
+
+    track(reply, DriverStatistics::Operation::DocumentDelete, 0);
 }
 
 void Arangodbdriver::_ar_document_updateStatus(Document *doc)
@@ -388,6 +1001,8 @@ void Arangodbdriver::_ar_document_updateStatus(Document *doc)
     connect(reply, &QNetworkReply::finished,
             doc, &Document::_ar_dataUpdated
             );
+
+    track(reply, DriverStatistics::Operation::DocumentHead, 0);
 }
 
 void Arangodbdriver::_ar_document_sync(Document *doc)
@@ -398,11 +1013,14 @@ void Arangodbdriver::_ar_document_sync(Document *doc)
     connect(reply, &QNetworkReply::finished,
             doc, &Document::_ar_dataIsAvailable
             );
+
+    track(reply, DriverStatistics::Operation::DocumentGet, 0);
 }
 
 void Arangodbdriver::_ar_edge_save(Document *doc)
 {
     Edge *e = qobject_cast<Edge *>(doc);
+
     d->jsonData = e->toJsonString();
     QByteArray jsonDataSize = QByteArray::number(d->jsonData.size());
 
@@ -413,6 +1031,7 @@ void Arangodbdriver::_ar_edge_save(Document *doc)
         request.setRawHeader("Content-Length", jsonDataSize);
 
         QNetworkReply *reply = Q_NULLPTR;
+        DriverStatistics::Operation operation = DriverStatistics::Operation::EdgeReplace;
 
         if ( e->isEveryAttributeDirty() ) {
             reply = d->networkManager.put(request, d->jsonData);
@@ -420,11 +1039,15 @@ void Arangodbdriver::_ar_edge_save(Document *doc)
         else {
             d->data.setBuffer(&d->jsonData);
             reply = d->networkManager.sendCustomRequest(request, QByteArrayLiteral("PATCH"), &d->data);
+            operation = DriverStatistics::Operation::EdgePatch;
         }
 
         connect(reply, &QNetworkReply::finished,
                 doc, &Edge::_ar_dataIsAvailable
                 );
+
+        invalidateAdjacency(reply, {e->from(), e->to()});
+        track(reply, operation, d->jsonData.size());
     }
     else {
         QString edgeUrl = d->standardUrl +
@@ -443,6 +1066,9 @@ void Arangodbdriver::_ar_edge_save(Document *doc)
         connect(reply, &QNetworkReply::finished,
                 doc, &Edge::_ar_dataIsAvailable
                 );
+
+        invalidateAdjacency(reply, {e->from(), e->to()});
+        track(reply, DriverStatistics::Operation::EdgeCreate, d->jsonData.size());
     }
 }
 
@@ -455,6 +1081,45 @@ void Arangodbdriver::_ar_edge_delete(Document *doc)
     connect(reply, &QNetworkReply::finished,
             doc, &Document::_ar_dataDeleted
             );
+
+    invalidateAdjacency(reply, {doc->get(internal::FROM).toString(), doc->get(internal::TO).toString()});
+
+    track(reply, DriverStatistics::Operation::EdgeDelete, 0);
+}
+
+void Arangodbdriver::_ar_edge_import(EdgeImport * import, int chunk, const QByteArray & body, const QStringList & vertices)
+{
+    QUrlQuery query;
+    query.addQueryItem(QStringLiteral("collection"), import->collection());
+    query.addQueryItem(QStringLiteral("type"), QStringLiteral("documents"));
+    query.addQueryItem(QStringLiteral("details"), QStringLiteral("true"));
+
+    QUrl url(d->standardUrl + QString("/import"));
+    url.setQuery(query);
+    QNetworkRequest request(url);
+    request.setRawHeader("Content-Type", "application/x-ldjson");
+    request.setRawHeader("Content-Length", QByteArray::number(body.size()));
+
+    QNetworkReply *reply = d->networkManager.post(request, body);
+    reply->setProperty("_ar_chunk", chunk);
+
+    connect(reply, &QNetworkReply::finished,
+            import, &EdgeImport::_ar_chunk_imported
+            );
+
+    // Imports created while the cache was disabled do not
+    // collect their vertices, the whole cache is dropped then
+    if ( d->isAdjacencyCacheEnabled && vertices.isEmpty() ) {
+        d->adjacencyCache.clear();
+        connect(reply, &QNetworkReply::finished, this, [this] {
+            d->adjacencyCache.clear();
+        });
+    }
+    else {
+        invalidateAdjacency(reply, vertices);
+    }
+
+    track(reply, DriverStatistics::Operation::EdgeImport, body.size());
 }
 
 void Arangodbdriver::_ar_collection_save(Collection * collection)
@@ -472,6 +1137,8 @@ void Arangodbdriver::_ar_collection_save(Collection * collection)
     connect(reply, &QNetworkReply::finished,
             collection, &Collection::_ar_dataIsAvailable
             );
+
+    track(reply, DriverStatistics::Operation::CollectionCreate, d->jsonData.size());
 }
 
 void Arangodbdriver::_ar_collection_load(Collection * collection)
@@ -488,6 +1155,8 @@ void Arangodbdriver::_ar_collection_load(Collection * collection)
     connect(reply, &QNetworkReply::finished,
             collection, &Collection::_ar_loaded
             );
+
+    track(reply, DriverStatistics::Operation::CollectionLoad, d->jsonData.size());
 }
 
 void Arangodbdriver::_ar_collection_delete(Collection * collection)
@@ -499,4 +1168,38 @@ void Arangodbdriver::_ar_collection_delete(Collection * collection)
     connect(reply, &QNetworkReply::finished,
             collection, &Collection::_ar_isDeleted
             );
+
+    track(reply, DriverStatistics::Operation::CollectionDelete, 0);
+}
+
+void Arangodbdriver::_ar_cursor_updated()
+{
+    QBCursor * cursor = qobject_cast<QBCursor *>(sender());
+    auto it = d->openCursors.find(cursor);
+
+    if ( it == d->openCursors.end() ) {
+        return;
+    }
+
+    // Cursors writing to a device only emit ready after their last
+    // batch, so every batch since the previous signal is logged here
+    auto & entry = it.value();
+    const QList<QBCursor::BatchStatistics> batches = cursor->batchStatistics();
+    if ( !entry.fingerprint.isEmpty() && !cursor->hasErrorOccurred() ) {
+        for ( int i = entry.loggedBatches; i < batches.size(); ++i ) {
+            const QBCursor::BatchStatistics & batch = batches.at(i);
+            d->queryLog.record(entry.fingerprint, entry.bindVars, i == 0,
+                               batch.rows, batch.bytes, batch.requestTime * 1000 + batch.decodeTime);
+        }
+    }
+    entry.loggedBatches = batches.size();
+
+    if ( entry.isDisposed ) {
+        d->openCursors.erase(it);
+        // Only the id is left of a cursor disposed before its first batch
+        deleteServerCursor(cursor->id());
+    }
+    else if ( cursor->hasErrorOccurred() || !cursor->hasMore() ) {
+        d->openCursors.erase(it);
+    }
 }
@@ -27,13 +27,28 @@
 #include "arangodb-driver_global.h"
 #include "Collection.h"
 #include "Document.h"
+#include "AdjacencyCache.h"
+#include "DriverStatistics.h"
 #include "Edge.h"
+#include "EdgeImport.h"
+#include "MemoryUsage.h"
 #include "QBSelect.h"
 #include "QBCursor.h"
+#include "QBExplain.h"
+#include "QBParallelScan.h"
+#include "QBTraversal.h"
+#include "QueryLog.h"
+#include "RequestTrace.h"
 #include <QtCore/QSharedPointer>
 
+#include <functional>
+
+class QNetworkReply;
+class QThreadPool;
+
 namespace internal {
 class ArangodbdriverPrivate;
+class JsonDecoder;
 }
 
 namespace arangodb
@@ -48,6 +63,36 @@ class ARANGODBDRIVERSHARED_EXPORT Arangodbdriver : public QObject
 {
         Q_OBJECT
     public:
+        /**
+         * @brief Information about a cursor which is
+         * still open on the server
+         *
+         * @since 0.6
+         */
+        struct CursorInfo {
+                /**
+                 * @brief id of the cursor on the server,
+                 * empty while the first batch is loading
+                 *
+                 * @since 0.6
+                 */
+                QString id;
+
+                /**
+                 * @brief milliseconds since the select was executed
+                 *
+                 * @since 0.6
+                 */
+                qint64 age;
+
+                /**
+                 * @brief number of batches loaded so far
+                 *
+                 * @since 0.6
+                 */
+                int loadedBatches;
+        };
+
         /**
          * @brief Arangodbdriver
          *
@@ -174,6 +219,19 @@ class ARANGODBDRIVERSHARED_EXPORT Arangodbdriver : public QObject
          */
         Edge* createEdge(QString collection, Document *fromDoc, Document *toDoc);
 
+        /**
+         * @brief Creates an import for many edges of the collection,
+         * which are sent in chunks without Document objects
+         *
+         * @param collection
+         * @param chunkSize     Number of edges per request
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        EdgeImport * createEdgeImport(const QString & collection, int chunkSize = 10000);
+
         /**
          * @brief executeSelect
          *
@@ -184,6 +242,153 @@ class ARANGODBDRIVERSHARED_EXPORT Arangodbdriver : public QObject
          */
         QSharedPointer<QBCursor> executeSelect(QSharedPointer<QBSelect> select);
 
+        /**
+         * @brief Executes the traversal as one query on the server,
+         * the visited vertices, edges or paths are loaded through
+         * the cursor
+         *
+         * @param traversal
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        QSharedPointer<QBCursor> executeTraversal(QSharedPointer<QBTraversal> traversal);
+
+        /**
+         * @brief Loads all edges of the edge collection which
+         * start or end at the vertex in one request through the
+         * edges API. The edges are returned as documents of the
+         * cursor, which never has more results.
+         *
+         * @param edgeCollection
+         * @param vertexId          Document id of the vertex
+         * @param direction
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        QSharedPointer<QBCursor> getEdges(const QString & edgeCollection,
+                                          const QString & vertexId,
+                                          QBTraversal::Direction direction = QBTraversal::Direction::Any);
+
+        /**
+         * @brief Returns the neighbors of the vertex in the edge
+         * collection and waits until they are loaded. With the
+         * adjacency cache enabled, lists of recently used vertices
+         * are answered from the cache. An empty list is returned
+         * if the edges could not be loaded.
+         *
+         * Waiting runs the event loop, so other slots, timers and
+         * replies are handled before this returns, which can call
+         * back into the caller. Use loadAdjacency() in slots.
+         *
+         * @param edgeCollection
+         * @param vertexId          Document id of the vertex
+         * @param direction
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        AdjacencyList adjacency(const QString & edgeCollection,
+                                const QString & vertexId,
+                                QBTraversal::Direction direction = QBTraversal::Direction::Any);
+
+        typedef std::function<void(const AdjacencyList & list, const QString & errorMessage)> AdjacencyCallback;
+
+        /**
+         * @brief Loads the neighbors of the vertex like adjacency()
+         * without waiting. The callback is called once the list is
+         * loaded, right away if it is answered from the cache.
+         * The error message is empty if the edges could be loaded.
+         *
+         * @param edgeCollection
+         * @param vertexId          Document id of the vertex
+         * @param direction
+         * @param callback
+         *
+         * @since 0.6
+         */
+        void loadAdjacency(const QString & edgeCollection,
+                           const QString & vertexId,
+                           QBTraversal::Direction direction,
+                           AdjacencyCallback callback);
+
+        /**
+         * @brief Enables or disables the adjacency cache used by
+         * adjacency(). Edges saved, dropped or imported through
+         * this driver invalidate the cached lists of their vertices,
+         * changes made by other clients are not seen while a
+         * list is cached. Disabling the cache clears it.
+         *
+         * @param enabled
+         *
+         * @since 0.6
+         */
+        void setAdjacencyCacheEnabled(bool enabled);
+
+        /**
+         * @brief isAdjacencyCacheEnabled
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        bool isAdjacencyCacheEnabled() const;
+
+        /**
+         * @brief Sets the memory limit of the adjacency cache,
+         * the default is 16 MB
+         *
+         * @param bytes
+         *
+         * @since 0.6
+         */
+        void setAdjacencyCacheLimit(int bytes);
+
+        /**
+         * @brief Returns the counters of the adjacency cache
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        AdjacencyCache::Statistics adjacencyCacheStatistics() const;
+
+        /**
+         * @brief Asks the server for the execution plan of the
+         * select without executing it
+         *
+         * @param select
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        QSharedPointer<QBExplain> explain(QSharedPointer<QBSelect> select);
+
+        /**
+         * @brief Exports all documents of the collection through
+         * the export API, which reads the collection directly
+         * instead of running a query. If a device is given, the
+         * documents are written to it as JSON lines instead of
+         * being turned into Document objects and all batches are
+         * loaded one after another (see QBCursor::setOutputDevice).
+         *
+         * @param collectionName
+         * @param options
+         * @param device
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        QSharedPointer<QBCursor> exportCollection(const QString & collectionName,
+                                                  const Collection::ExportOptions & options = Collection::ExportOptions(),
+                                                  QIODevice * device = Q_NULLPTR);
+
         /**
          * @brief loadMoreResults
          *
@@ -193,6 +398,186 @@ class ARANGODBDRIVERSHARED_EXPORT Arangodbdriver : public QObject
          */
         void loadMoreResults(QBCursor * cursor);
 
+        /**
+         * @brief Releases the cursor on the server if it still has
+         * results there and removes it from the open cursors.
+         * Called by QBCursor::dispose(). A cursor whose first batch
+         * has not arrived yet stays open until its id is known.
+         *
+         * @param cursor
+         *
+         * @since 0.6
+         */
+        void disposeCursor(QBCursor * cursor);
+
+        /**
+         * @brief Returns the number of cursors which are loading
+         * or still have results on the server
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        int openCursorCount() const;
+
+        /**
+         * @brief Returns all cursors which are loading
+         * or still have results on the server
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        QList<CursorInfo> openCursors() const;
+
+        /**
+         * @brief Returns a snapshot of the counters and latency
+         * histograms of all requests sent by the driver
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        DriverStatistics statistics() const;
+
+        /**
+         * @brief Sets all statistics back to 0
+         *
+         * @since 0.6
+         */
+        void resetStatistics();
+
+        /**
+         * @brief Cursor batches with at least the given bytes are
+         * parsed on the decode thread pool instead of the event
+         * loop, so they don't hold up the other replies. A
+         * negative value parses everything on the event loop,
+         * the default is 1 MB.
+         *
+         * @param bytes
+         *
+         * @since 0.6
+         */
+        void setBackgroundDecodeThreshold(int bytes);
+
+        /**
+         * @brief backgroundDecodeThreshold
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        int backgroundDecodeThreshold() const;
+
+        /**
+         * @brief Sets the pool for parsing big cursor batches,
+         * nullptr uses QThreadPool::globalInstance
+         *
+         * @param pool
+         *
+         * @since 0.6
+         */
+        void setDecodeThreadPool(QThreadPool * pool);
+
+        /**
+         * @brief decodeThreadPool
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        QThreadPool * decodeThreadPool() const;
+
+        /**
+         * @brief Returns the approximate memory held by
+         * documents, cursors, running requests and caches
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        MemoryUsage memoryUsage() const;
+
+        /**
+         * @brief Sets a soft limit for MemoryUsage::total, 0 means
+         * no limit. Whenever a reply is finished above the limit,
+         * the adjacency cache evicts until the total fits. If it
+         * still doesn't, memoryLimitExceeded is emitted and
+         * QBParallelScan slows down to one range at a time.
+         *
+         * @param bytes
+         *
+         * @since 0.6
+         */
+        void setMemorySoftLimit(qint64 bytes);
+
+        /**
+         * @brief memorySoftLimit
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        qint64 memorySoftLimit() const;
+
+        /**
+         * @brief Returns true if a soft limit is set and
+         * the memory usage is above it
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        bool isOverMemoryLimit() const;
+
+        /**
+         * @brief Logs every round trip of a select or traversal
+         * which takes longer than the given milliseconds as
+         * warning, a negative value disables the log
+         *
+         * @param milliseconds
+         *
+         * @since 0.6
+         */
+        void setSlowQueryThreshold(int milliseconds);
+
+        /**
+         * @brief slowQueryThreshold
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        int slowQueryThreshold() const;
+
+        /**
+         * @brief Returns the round trips of all selects and traversals
+         * aggregated by query fingerprint (see QueryLog)
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        QList<QueryLog::QueryStatistics> queryStatistics() const;
+
+        /**
+         * @brief resetQueryStatistics
+         *
+         * @since 0.6
+         */
+        void resetQueryStatistics();
+
+        /**
+         * @brief Sets a callback which is called with the phase
+         * timings of every request once its reply is decoded,
+         * an empty callback disables tracing
+         *
+         * @param callback
+         *
+         * @since 0.6
+         */
+        void setTraceCallback(std::function<void(const RequestTrace &)> callback);
+
         /**
          * @brief Variadic template method to wait for an
          * unlimited number of Document's, Collection's
@@ -238,6 +623,18 @@ class ARANGODBDRIVERSHARED_EXPORT Arangodbdriver : public QObject
             waitUntilFinished(others...);
         }
 
+    Q_SIGNALS:
+        /**
+         * @brief Emitted when the memory usage rises above the soft
+         * limit and the caches couldn't free enough memory
+         *
+         * @param usage
+         * @param limit
+         *
+         * @since 0.6
+         */
+        void memoryLimitExceeded(qint64 usage, qint64 limit);
+
     protected:
         void privateWaitUntilFinished(Collection * collection);
         void privateWaitUntilFinished(Document * document);
@@ -297,6 +694,18 @@ class ARANGODBDRIVERSHARED_EXPORT Arangodbdriver : public QObject
          */
         void _ar_edge_delete(Document *doc);
 
+        /**
+         * @brief _ar_edge_import
+         *
+         * @param import
+         * @param chunk
+         * @param body
+         * @param vertices
+         *
+         * @since 0.6
+         */
+        void _ar_edge_import(EdgeImport * import, int chunk, const QByteArray & body, const QStringList & vertices);
+
         /**
          * @brief _ar_collection_save
          *
@@ -327,7 +736,99 @@ class ARANGODBDRIVERSHARED_EXPORT Arangodbdriver : public QObject
          */
         void _ar_collection_delete(Collection * collection);
 
+        /**
+         * @brief Keeps the open cursors up to date
+         * after every loaded batch
+         *
+         * @since 0.6
+         */
+        void _ar_cursor_updated();
+
     private:
+        friend class QBCursor;
+        friend class QBParallelScan;
+
+        QSharedPointer<QBCursor> createCursor();
+
+        /**
+         * @brief Runs an AQL query which is not built by
+         * one of the query builders
+         *
+         * @param query
+         * @param bindVars
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        QSharedPointer<QBCursor> executeQuery(const QString & query, const QVariantMap & bindVars);
+        void postCursorRequest(QBCursor * cursor, const QString & path, const QByteArray & body);
+
+        /**
+         * @brief Called by the destructor of the cursor. If the first
+         * batch is still on its way, the driver takes over its reply
+         * or its pending decode to release the server cursor.
+         *
+         * @param cursor
+         * @param decoder   Pending decode of the cursor or null
+         *
+         * @since 0.6
+         */
+        void abandonCursor(QBCursor * cursor, internal::JsonDecoder * decoder);
+
+        /**
+         * @brief Releases the server cursor of a first batch
+         * which no cursor object is waiting for anymore
+         *
+         * @param batch
+         *
+         * @since 0.6
+         */
+        void releaseCursorBatch(const QJsonObject & batch);
+
+        /**
+         * @brief Drops the cached adjacency lists of the vertices
+         * when the request is sent and again when its reply has
+         * arrived, as a list loaded in between can still miss
+         * the change
+         *
+         * @param reply
+         * @param vertices
+         *
+         * @since 0.6
+         */
+        void invalidateAdjacency(QNetworkReply * reply, const QStringList & vertices);
+
+        /**
+         * @brief Sends the request to delete the server cursor
+         *
+         * @param id
+         *
+         * @since 0.6
+         */
+        void deleteServerCursor(const QString & id);
+
+        /**
+         * @brief Counts the request in the statistics, called
+         * after the consumer has been connected to the reply
+         *
+         * @param reply
+         * @param operation
+         * @param bytesSent
+         *
+         * @since 0.6
+         */
+        void track(QNetworkReply * reply, DriverStatistics::Operation operation, qint64 bytesSent);
+
+        /**
+         * @brief Trims the caches if the memory usage is above
+         * the soft limit and emits memoryLimitExceeded if
+         * that is not enough
+         *
+         * @since 0.6
+         */
+        void checkMemoryLimit();
+
         internal::ArangodbdriverPrivate *d;
 };
 
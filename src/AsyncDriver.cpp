@@ -0,0 +1,329 @@
+/********************************************************************************
+ ** The MIT License (MIT)
+ **
+ ** Copyright (c) 2013 Sascha Ludwig Häusler
+ **
+ ** Permission is hereby granted, free of charge, to any person obtaining a copy of
+ ** this software and associated documentation files (the "Software"), to deal in
+ ** the Software without restriction, including without limitation the rights to
+ ** use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ ** the Software, and to permit persons to whom the Software is furnished to do so,
+ ** subject to the following conditions:
+ **
+ ** The above copyright notice and this permission notice shall be included in all
+ ** copies or substantial portions of the Software.
+ **
+ ** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ ** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ ** FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ ** COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ ** IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ ** CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *********************************************************************************/
+
+#include "AsyncDriver.h"
+#include "Arangodbdriver.h"
+#include "private/MpscQueue_p.h"
+
+#include <QtCore/QAtomicInt>
+#include <QtCore/QAtomicPointer>
+#include <QtCore/QCoreApplication>
+#include <QtCore/QEvent>
+#include <QtCore/QHash>
+#include <QtCore/QSemaphore>
+#include <QtCore/QThread>
+
+#include <memory>
+
+namespace arangodb
+{
+
+namespace {
+
+const QEvent::Type DrainEventType = QEvent::Type(QEvent::registerEventType());
+
+}
+
+class AsyncDriverPrivate
+{
+    public:
+        AsyncDriverPrivate(AsyncDriver * q) :
+            defaultExecutor(q),
+            executor(&defaultExecutor)
+        {
+        }
+
+        QString protocol;
+        QString host;
+        qint32 port;
+
+        internal::MpscQueue<AsyncDriver::Operation> queue;
+        QAtomicInt isDrainScheduled;
+
+        QThread * thread = nullptr;
+        QSemaphore started;
+
+        // Only used on the I/O thread
+        Arangodbdriver * driver = nullptr;
+        QObject * dispatcher = nullptr;
+
+        EventLoopExecutor defaultExecutor;
+        // Set by the owner thread, read by the I/O thread
+        QAtomicPointer<CallbackExecutor> executor;
+
+        struct RunningSelect {
+            QSharedPointer<QBCursor> cursor;
+            QList<QJsonObject> rows;
+            AsyncDriver::RowsCallback callback;
+        };
+
+        QHash<QBCursor *, RunningSelect> runningSelects;
+
+        // Released by the next drain, a cursor can't be
+        // deleted while it is emitting its signal
+        QList<QSharedPointer<QBCursor>> finishedCursors;
+
+        inline void scheduleDrain() {
+            if ( isDrainScheduled.testAndSetOrdered(0, 1) ) {
+                QCoreApplication::postEvent(dispatcher, new QEvent(DrainEventType));
+            }
+        }
+
+        void drain();
+        void complete(Document * doc, AsyncDriver::DocumentCallback callback);
+        void selectBatchLoaded(QBCursor * cursor);
+        void selectFailed(QBCursor * cursor);
+        void finishSelect(QBCursor * cursor, const QString & errorMessage);
+};
+
+/**
+ * @brief Receives the drain events on the I/O thread
+ */
+class AsyncDriverDispatcher : public QObject
+{
+    public:
+        explicit AsyncDriverDispatcher(AsyncDriverPrivate * d) :
+            d(d)
+        {
+        }
+
+        bool event(QEvent * event) override {
+            if ( event->type() == DrainEventType ) {
+                d->drain();
+                return true;
+            }
+
+            return QObject::event(event);
+        }
+
+    private:
+        AsyncDriverPrivate * d;
+};
+
+/**
+ * @brief Creates the driver on its own thread, its network
+ * manager belongs to the thread it was created in
+ */
+class AsyncDriverThread : public QThread
+{
+    public:
+        explicit AsyncDriverThread(AsyncDriverPrivate * d) :
+            d(d)
+        {
+        }
+
+    protected:
+        void run() override {
+            Arangodbdriver driver(d->protocol, d->host, d->port);
+            AsyncDriverDispatcher dispatcher(d);
+
+            d->driver = &driver;
+            d->dispatcher = &dispatcher;
+            d->started.release();
+
+            exec();
+
+            // The cursors are children of the driver
+            d->finishedCursors.clear();
+            d->runningSelects.clear();
+        }
+
+    private:
+        AsyncDriverPrivate * d;
+};
+
+void AsyncDriverPrivate::drain()
+{
+    // Cleared first, a push after this point schedules a new drain
+    isDrainScheduled.fetchAndStoreOrdered(0);
+    finishedCursors.clear();
+
+    AsyncDriver::Operation operation;
+    int count = 0;
+    while ( count < AsyncDriver::MaxOperationsPerDrain && queue.pop(&operation) ) {
+        operation(driver);
+        ++count;
+    }
+
+    if ( count == AsyncDriver::MaxOperationsPerDrain ) {
+        scheduleDrain();
+    }
+}
+
+void AsyncDriverPrivate::complete(Document * doc, AsyncDriver::DocumentCallback callback)
+{
+    QObject::connect(doc, &Document::ready, doc, [this, doc, callback] {
+        const QJsonObject document = doc->toJsonObject();
+        doc->deleteLater();
+
+        executor.loadAcquire()->execute([callback, document] {
+            callback(document, QString());
+        });
+    });
+
+    QObject::connect(doc, &Document::error, doc, [this, doc, callback] {
+        const QString errorMessage = doc->errorMessage();
+        doc->deleteLater();
+
+        executor.loadAcquire()->execute([callback, errorMessage] {
+            callback(QJsonObject(), errorMessage);
+        });
+    });
+}
+
+void AsyncDriverPrivate::selectBatchLoaded(QBCursor * cursor)
+{
+    auto it = runningSelects.find(cursor);
+    if ( it == runningSelects.end() ) {
+        return;
+    }
+
+    for ( Document * doc : cursor->data() ) {
+        it.value().rows.append(doc->toJsonObject());
+    }
+    cursor->clearData();
+
+    if ( cursor->hasMore() ) {
+        cursor->getMoreData();
+        return;
+    }
+
+    finishSelect(cursor, QString());
+}
+
+void AsyncDriverPrivate::selectFailed(QBCursor * cursor)
+{
+    finishSelect(cursor, cursor->errorMessage());
+}
+
+void AsyncDriverPrivate::finishSelect(QBCursor * cursor, const QString & errorMessage)
+{
+    auto it = runningSelects.find(cursor);
+    if ( it == runningSelects.end() ) {
+        return;
+    }
+
+    const QList<QJsonObject> rows = it.value().rows;
+    const AsyncDriver::RowsCallback callback = it.value().callback;
+
+    finishedCursors.append(it.value().cursor);
+    runningSelects.erase(it);
+    scheduleDrain();
+
+    executor.loadAcquire()->execute([callback, rows, errorMessage] {
+        callback(rows, errorMessage);
+    });
+}
+
+AsyncDriver::AsyncDriver(QString protocol, QString host, qint32 port, QObject * parent) :
+    QObject(parent),
+    d_ptr(new AsyncDriverPrivate(this))
+{
+    Q_D(AsyncDriver);
+    d->protocol = protocol;
+    d->host = host;
+    d->port = port;
+
+    d->thread = new AsyncDriverThread(d);
+    d->thread->setObjectName(QStringLiteral("arangodb-io"));
+    d->thread->start();
+
+    // Operations can only be posted once the dispatcher exists
+    d->started.acquire();
+}
+
+AsyncDriver::~AsyncDriver()
+{
+    Q_D(AsyncDriver);
+
+    d->thread->quit();
+    d->thread->wait();
+    delete d->thread;
+
+    delete d_ptr;
+}
+
+void AsyncDriver::setCallbackExecutor(CallbackExecutor * executor)
+{
+    Q_D(AsyncDriver);
+    d->executor.storeRelease((executor == nullptr) ? &d->defaultExecutor : executor);
+}
+
+CallbackExecutor * AsyncDriver::callbackExecutor() const
+{
+    Q_D(const AsyncDriver);
+    return d->executor.loadAcquire();
+}
+
+void AsyncDriver::submit(Operation operation)
+{
+    Q_D(AsyncDriver);
+
+    d->queue.push(std::move(operation));
+    d->scheduleDrain();
+}
+
+void AsyncDriver::getDocument(const QString & id, DocumentCallback callback)
+{
+    Q_D(AsyncDriver);
+
+    submit([d, id, callback](Arangodbdriver * driver) {
+        d->complete(driver->getDocument(id), callback);
+    });
+}
+
+void AsyncDriver::saveDocument(const QString & collection, const QJsonObject & attributes, DocumentCallback callback)
+{
+    Q_D(AsyncDriver);
+
+    submit([d, collection, attributes, callback](Arangodbdriver * driver) {
+        Document * doc = driver->createDocument(collection);
+        for ( auto it = attributes.constBegin(); it != attributes.constEnd(); ++it ) {
+            doc->set(it.key(), it.value().toVariant());
+        }
+
+        d->complete(doc, callback);
+        doc->save();
+    });
+}
+
+void AsyncDriver::executeSelect(QSharedPointer<QBSelect> select, RowsCallback callback)
+{
+    Q_D(AsyncDriver);
+
+    submit([d, select, callback](Arangodbdriver * driver) {
+        QSharedPointer<QBCursor> cursor = driver->executeSelect(select);
+        QBCursor * key = cursor.data();
+
+        d->runningSelects.insert(key, {cursor, QList<QJsonObject>(), callback});
+
+        QObject::connect(key, &QBCursor::ready, key, [d, key] {
+            d->selectBatchLoaded(key);
+        });
+        QObject::connect(key, &QBCursor::error, key, [d, key] {
+            d->selectFailed(key);
+        });
+    });
+}
+
+}
@@ -0,0 +1,197 @@
+/********************************************************************************
+ ** The MIT License (MIT)
+ **
+ ** Copyright (c) 2013 Sascha Ludwig Häusler
+ **
+ ** Permission is hereby granted, free of charge, to any person obtaining a copy of
+ ** this software and associated documentation files (the "Software"), to deal in
+ ** the Software without restriction, including without limitation the rights to
+ ** use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ ** the Software, and to permit persons to whom the Software is furnished to do so,
+ ** subject to the following conditions:
+ **
+ ** The above copyright notice and this permission notice shall be included in all
+ ** copies or substantial portions of the Software.
+ **
+ ** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ ** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ ** FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ ** COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ ** IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ ** CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *********************************************************************************/
+
+#ifndef ASYNCDRIVER_H
+#define ASYNCDRIVER_H
+
+#include "arangodb-driver_global.h"
+#include "CallbackExecutor.h"
+#include "QBSelect.h"
+
+#include <QtCore/QJsonObject>
+#include <QtCore/QList>
+#include <QtCore/QObject>
+#include <QtCore/QSharedPointer>
+
+#include <functional>
+
+namespace arangodb
+{
+
+class Arangodbdriver;
+class AsyncDriverPrivate;
+
+/**
+ * @brief Runs an Arangodbdriver on a dedicated I/O thread, so
+ * it can be used from any number of threads at the same time.
+ * All of them share the connections of the one network manager.
+ *
+ * Operations are pushed into a lock-free queue, which the I/O
+ * thread drains in its event loop. The results are handed to
+ * the callback executor, which by default runs the callbacks
+ * in the thread the AsyncDriver was created in.
+ *
+ * @code
+ * AsyncDriver driver;
+ * // from any thread
+ * driver.getDocument("users/42", [](const QJsonObject & doc, const QString & error) {
+ *     ...
+ * });
+ * @endcode
+ *
+ * @since 0.6
+ */
+class ARANGODBDRIVERSHARED_EXPORT AsyncDriver : public QObject
+{
+        Q_OBJECT
+    public:
+        /**
+         * @brief Runs on the I/O thread with its driver
+         *
+         * @since 0.6
+         */
+        typedef std::function<void(Arangodbdriver * driver)> Operation;
+
+        /**
+         * @brief Gets all attributes of the document or an
+         * empty object and the error message
+         *
+         * @since 0.6
+         */
+        typedef std::function<void(const QJsonObject & document, const QString & errorMessage)> DocumentCallback;
+
+        /**
+         * @brief Gets the rows of all batches or the error
+         * message and the rows loaded so far
+         *
+         * @since 0.6
+         */
+        typedef std::function<void(const QList<QJsonObject> & rows, const QString & errorMessage)> RowsCallback;
+
+        /**
+         * @brief Starts the I/O thread and creates its driver
+         *
+         * @param protocol
+         * @param host
+         * @param port
+         * @param parent
+         *
+         * @since 0.6
+         */
+        AsyncDriver(QString protocol = QString("http"),
+                    QString host = QString("localhost"),
+                    qint32 port = 8529,
+                    QObject * parent = nullptr);
+
+        /**
+         * @brief Stops the I/O thread, running requests are
+         * aborted and their callbacks are not called
+         *
+         * @since 0.6
+         */
+        virtual ~AsyncDriver();
+
+        /**
+         * @brief Sets the executor for all callbacks, nullptr sets
+         * the default back. Callbacks of operations which are
+         * already running may still use the previous executor,
+         * so every executor has to live longer than the AsyncDriver.
+         *
+         * @param executor
+         *
+         * @since 0.6
+         */
+        void setCallbackExecutor(CallbackExecutor * executor);
+
+        /**
+         * @brief callbackExecutor
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        CallbackExecutor * callbackExecutor() const;
+
+        /**
+         * @brief Runs the operation on the I/O thread, can be called
+         * from any thread. The operations of one thread are run
+         * in the order they were submitted.
+         *
+         * @param operation
+         *
+         * @since 0.6
+         */
+        void submit(Operation operation);
+
+        /**
+         * @brief Loads the document, can be called from any thread
+         *
+         * @param id
+         * @param callback
+         *
+         * @since 0.6
+         */
+        void getDocument(const QString & id, DocumentCallback callback);
+
+        /**
+         * @brief Creates a document with the attributes, can be called
+         * from any thread. The callback gets the attributes together
+         * with _id, _key and _rev.
+         *
+         * @param collection
+         * @param attributes
+         * @param callback
+         *
+         * @since 0.6
+         */
+        void saveDocument(const QString & collection, const QJsonObject & attributes, DocumentCallback callback);
+
+        /**
+         * @brief Executes the select and loads all batches, can be called
+         * from any thread. The select must not be changed afterwards.
+         *
+         * @param select
+         * @param callback
+         *
+         * @since 0.6
+         */
+        void executeSelect(QSharedPointer<QBSelect> select, RowsCallback callback);
+
+        /**
+         * @brief Maximum number of operations run in one go,
+         * before the network events get their turn again
+         *
+         * @since 0.6
+         */
+        static const int MaxOperationsPerDrain = 256;
+
+    protected:
+        AsyncDriverPrivate *d_ptr;
+
+    private:
+        Q_DECLARE_PRIVATE(AsyncDriver)
+};
+
+}
+
+#endif // ASYNCDRIVER_H
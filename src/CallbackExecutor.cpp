@@ -0,0 +1,88 @@
+/********************************************************************************
+ ** The MIT License (MIT)
+ **
+ ** Copyright (c) 2013 Sascha Ludwig Häusler
+ **
+ ** Permission is hereby granted, free of charge, to any person obtaining a copy of
+ ** this software and associated documentation files (the "Software"), to deal in
+ ** the Software without restriction, including without limitation the rights to
+ ** use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ ** the Software, and to permit persons to whom the Software is furnished to do so,
+ ** subject to the following conditions:
+ **
+ ** The above copyright notice and this permission notice shall be included in all
+ ** copies or substantial portions of the Software.
+ **
+ ** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ ** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ ** FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ ** COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ ** IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ ** CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *********************************************************************************/
+
+#include "CallbackExecutor.h"
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QEvent>
+
+using namespace arangodb;
+
+namespace {
+
+const QEvent::Type CallbackEventType = QEvent::Type(QEvent::registerEventType());
+
+class CallbackEvent : public QEvent
+{
+    public:
+        explicit CallbackEvent(std::function<void()> callback) :
+            QEvent(CallbackEventType),
+            callback(std::move(callback))
+        {
+        }
+
+        std::function<void()> callback;
+};
+
+/**
+ * @brief Lives in the thread of the context and runs the
+ * callbacks, posted events are removed with the receiver
+ */
+class CallbackReceiver : public QObject
+{
+    public:
+        bool event(QEvent * event) override {
+            if ( event->type() == CallbackEventType ) {
+                static_cast<CallbackEvent *>(event)->callback();
+                return true;
+            }
+
+            return QObject::event(event);
+        }
+};
+
+}
+
+CallbackExecutor::~CallbackExecutor()
+{
+}
+
+EventLoopExecutor::EventLoopExecutor(QObject * context) :
+    m_context(context),
+    m_receiver(new CallbackReceiver)
+{
+    m_receiver->moveToThread(context->thread());
+}
+
+EventLoopExecutor::~EventLoopExecutor()
+{
+    m_receiver->deleteLater();
+}
+
+void EventLoopExecutor::execute(std::function<void()> callback)
+{
+    QPointer<QObject> context = m_context;
+    QCoreApplication::postEvent(m_receiver, new CallbackEvent([context, callback] {
+        if ( context ) callback();
+    }));
+}
@@ -0,0 +1,109 @@
+/********************************************************************************
+ ** The MIT License (MIT)
+ **
+ ** Copyright (c) 2013 Sascha Ludwig Häusler
+ **
+ ** Permission is hereby granted, free of charge, to any person obtaining a copy of
+ ** this software and associated documentation files (the "Software"), to deal in
+ ** the Software without restriction, including without limitation the rights to
+ ** use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ ** the Software, and to permit persons to whom the Software is furnished to do so,
+ ** subject to the following conditions:
+ **
+ ** The above copyright notice and this permission notice shall be included in all
+ ** copies or substantial portions of the Software.
+ **
+ ** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ ** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ ** FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ ** COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ ** IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ ** CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *********************************************************************************/
+
+#ifndef CALLBACKEXECUTOR_H
+#define CALLBACKEXECUTOR_H
+
+#include "arangodb-driver_global.h"
+
+#include <QtCore/QObject>
+#include <QtCore/QPointer>
+
+#include <functional>
+
+namespace arangodb
+{
+
+/**
+ * @brief Runs the completion callbacks of AsyncDriver,
+ * execute is called from the I/O thread of the driver
+ *
+ * @since 0.6
+ */
+class ARANGODBDRIVERSHARED_EXPORT CallbackExecutor
+{
+    public:
+        /**
+         * @brief ~CallbackExecutor
+         *
+         * @since 0.6
+         */
+        virtual ~CallbackExecutor();
+
+        /**
+         * @brief Runs the callback or schedules it, must
+         * be safe to call from any thread
+         *
+         * @param callback
+         *
+         * @since 0.6
+         */
+        virtual void execute(std::function<void()> callback) = 0;
+};
+
+/**
+ * @brief Runs the callbacks in the event loop of the thread
+ * the context object lives in. Callbacks which are still
+ * waiting when the context or the executor is deleted
+ * are dropped.
+ *
+ * @since 0.6
+ */
+class ARANGODBDRIVERSHARED_EXPORT EventLoopExecutor : public CallbackExecutor
+{
+    public:
+        /**
+         * @brief EventLoopExecutor
+         *
+         * @param context
+         *
+         * @since 0.6
+         */
+        explicit EventLoopExecutor(QObject * context);
+
+        /**
+         * @brief ~EventLoopExecutor
+         *
+         * @since 0.6
+         */
+        virtual ~EventLoopExecutor();
+
+        /**
+         * @brief execute
+         *
+         * @param callback
+         *
+         * @since 0.6
+         */
+        void execute(std::function<void()> callback) override;
+
+    private:
+        QPointer<QObject> m_context;
+        QObject * m_receiver;
+
+        Q_DISABLE_COPY(EventLoopExecutor)
+};
+
+}
+
+#endif // CALLBACKEXECUTOR_H
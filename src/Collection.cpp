@@ -27,6 +27,7 @@
 #include "Document.h"
 
 #include <QtCore/QCoreApplication>
+#include <QtCore/QDebug>
 #include <QtCore/QJsonDocument>
 #include <QtCore/QJsonObject>
 #include <QtNetwork/QNetworkReply>
@@ -187,6 +188,26 @@ Document *Collection::createDocument(const QString & key)
     }
 }
 
+QSharedPointer<QBCursor> Collection::exportAll(const ExportOptions & options)
+{
+    return exportAll(Q_NULLPTR, options);
+}
+
+QSharedPointer<QBCursor> Collection::exportAll(QIODevice * device, const ExportOptions & options)
+{
+    Q_D(Collection);
+
+    Arangodbdriver * driver = Q_NULLPTR;
+    if ( (driver = qobject_cast<Arangodbdriver *>(parent())) ) {
+        return driver->exportCollection(d->name, options, device);
+    }
+    else {
+        qWarning() << Q_FUNC_INFO;
+        qWarning() << "Parent is not Arangodbdriver";
+        return QSharedPointer<QBCursor>();
+    }
+}
+
 void Collection::save()
 {
     Q_EMIT saveData(this);
@@ -26,13 +26,18 @@
 
 #include "arangodb-driver_global.h"
 
+#include <QtCore/QIODevice>
+#include <QtCore/QJsonArray>
 #include <QtCore/QJsonObject>
+#include <QtCore/QSharedPointer>
 #include <QtCore/QString>
+#include <QtCore/QStringList>
 
 namespace arangodb
 {
 
 class Document;
+class QBCursor;
 
 class CollectionPrivate;
 
@@ -121,6 +126,99 @@ class ARANGODBDRIVERSHARED_EXPORT Collection : public QObject
                 }
         };
 
+        /**
+         * @brief Options of an export of all documents
+         *
+         * @since 0.6
+         */
+        struct ExportOptions {
+                /**
+                 * @brief The RestrictType enum
+                 *
+                 * @since 0.6
+                 */
+                enum class RestrictType {
+                    NoRestriction = 0,
+                    IncludeFields = 1,
+                    ExcludeFields = 2
+                };
+
+                ExportOptions() :
+                    batchSize(1000),
+                    ttl(-1),
+                    limit(-1),
+                    flush(false),
+                    restrictType(RestrictType::NoRestriction)
+                {
+                }
+
+                /**
+                 * @brief number of documents per batch
+                 *
+                 * @since 0.6
+                 */
+                int batchSize;
+
+                /**
+                 * @brief time to live of the export cursor in seconds,
+                 * values below 1 keep the server default
+                 *
+                 * @since 0.6
+                 */
+                int ttl;
+
+                /**
+                 * @brief maximal number of exported documents,
+                 * values below 1 export everything
+                 *
+                 * @since 0.6
+                 */
+                int limit;
+
+                /**
+                 * @brief if set to true, the server flushes the write
+                 * ahead log first so the export contains all documents
+                 *
+                 * @since 0.6
+                 */
+                bool flush;
+
+                /**
+                 * @brief whether fields contains the only exported
+                 * attributes or the attributes left out
+                 *
+                 * @since 0.6
+                 */
+                RestrictType restrictType;
+
+                /**
+                 * @brief attributes for the restriction
+                 *
+                 * @since 0.6
+                 */
+                QStringList fields;
+
+                QJsonObject object() const {
+                    QJsonObject obj;
+
+                    obj.insert(QStringLiteral("batchSize"), batchSize);
+                    obj.insert(QStringLiteral("flush"), flush);
+                    if ( ttl > 0 ) obj.insert(QStringLiteral("ttl"), ttl);
+                    if ( limit > 0 ) obj.insert(QStringLiteral("limit"), limit);
+
+                    if ( restrictType != RestrictType::NoRestriction ) {
+                        QJsonObject restrict;
+                        restrict.insert(QStringLiteral("type"),
+                                        (restrictType == RestrictType::IncludeFields) ? QStringLiteral("include")
+                                                                                       : QStringLiteral("exclude"));
+                        restrict.insert(QStringLiteral("fields"), QJsonArray::fromStringList(fields));
+                        obj.insert(QStringLiteral("restrict"), restrict);
+                    }
+
+                    return obj;
+                }
+        };
+
         /**
          * @brief The Type enum
          *
@@ -358,6 +456,34 @@ class ARANGODBDRIVERSHARED_EXPORT Collection : public QObject
          */
         Document * createDocument(const QString & key);
 
+        /**
+         * @brief Exports all documents of the collection. Needs
+         * the collection to be created by an Arangodbdriver,
+         * otherwise a null pointer is returned.
+         *
+         * @param options
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        QSharedPointer<QBCursor> exportAll(const ExportOptions & options = ExportOptions());
+
+        /**
+         * @brief Exports all documents of the collection as JSON
+         * lines into the device without creating Document objects.
+         * The returned cursor emits ready once the last batch has
+         * been written.
+         *
+         * @param device
+         * @param options
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        QSharedPointer<QBCursor> exportAll(QIODevice * device, const ExportOptions & options = ExportOptions());
+
         /**
          * @brief save
          *
@@ -60,19 +60,7 @@ Document::Document(QString collection, QString key, QObject *parent) :
 Document::Document(QJsonObject obj, QObject * parent) :
     Document(new internal::DocumentPrivate, parent)
 {
-    if ( obj.contains(internal::ID) ) {
-        obj.remove(QStringLiteral("n"));
-        d_func()->collectionName = obj.value(internal::ID).toString().split('/').at(0);
-        d_func()->data.insert(internal::ID, obj.value(internal::ID));
-        d_func()->data.insert(internal::KEY, obj.value(internal::KEY));
-        d_func()->data.insert(internal::REV, obj.value(internal::REV));
-        d_func()->isCurrent = false;
-    }
-    else {
-        for ( auto key : obj.keys() ) {
-            d_func()->data.insert(key, obj[key]);
-        }
-    }
+    d_func()->setCursorResult(obj);
 }
 
 Document::~Document()
@@ -119,6 +107,11 @@ QByteArray Document::toJsonString() const
     return doc.toJson();
 }
 
+QJsonObject Document::toJsonObject() const
+{
+    return d_func()->data;
+}
+
 QString Document::docID() const
 {
     return d_func()->data.value(internal::ID).toString();
@@ -167,7 +160,7 @@ bool Document::hasErrorOccurred()
 void Document::set(const QString &key, QVariant data)
 {
     d_func()->dirtyAttributes.append(key);
-    d_func()->data.insert(key, QJsonValue::fromVariant(data));
+    d_func()->insert(key, QJsonValue::fromVariant(data));
     d_func()->isDirty = true;
 }
 
@@ -246,7 +239,7 @@ void Document::_ar_dataIsAvailable()
         d_func()->isCurrent = true;
 
         for ( auto key : obj.keys() ) {
-            d_func()->data.insert(key, obj[key]);
+            d_func()->insert(key, obj[key]);
         }
 
         d_func()->resetError();
@@ -130,6 +130,16 @@ class ARANGODBDRIVERSHARED_EXPORT Document : public QObject
          */
         virtual QByteArray toJsonString() const;
 
+        /**
+         * @brief Returns all attributes, system
+         * attributes included
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        QJsonObject toJsonObject() const;
+
         /**
          * @brief docID
          *
@@ -402,6 +412,7 @@ class ARANGODBDRIVERSHARED_EXPORT Document : public QObject
 
     private:
         Q_DECLARE_PRIVATE(internal::Document)
+        friend class QBCursor;
 };
 
 }
@@ -0,0 +1,293 @@
+/********************************************************************************
+ ** The MIT License (MIT)
+ **
+ ** Copyright (c) 2013 Sascha Ludwig Häusler
+ **
+ ** Permission is hereby granted, free of charge, to any person obtaining a copy of
+ ** this software and associated documentation files (the "Software"), to deal in
+ ** the Software without restriction, including without limitation the rights to
+ ** use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ ** the Software, and to permit persons to whom the Software is furnished to do so,
+ ** subject to the following conditions:
+ **
+ ** The above copyright notice and this permission notice shall be included in all
+ ** copies or substantial portions of the Software.
+ **
+ ** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ ** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ ** FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ ** COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ ** IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ ** CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *********************************************************************************/
+
+#include "DriverStatistics.h"
+
+#include <limits>
+
+namespace arangodb
+{
+
+namespace {
+
+const qint64 FixedBounds[LatencyHistogram::FixedBoundCount] = {
+    500, 1000, 2500, 5000, 10000, 25000, 50000,
+    100000, 250000, 500000, 1000000, 2500000, 5000000, 10000000
+};
+
+}
+
+LatencyHistogram::LatencyHistogram() :
+    m_buckets(BucketCount, 0),
+    m_fixedBoundCounts(FixedBoundCount, 0),
+    m_count(0),
+    m_sum(0),
+    m_min(std::numeric_limits<qint64>::max()),
+    m_max(0)
+{
+}
+
+int LatencyHistogram::bucketOf(qint64 microseconds)
+{
+    quint64 value = quint64(qBound(qint64(0), microseconds, (qint64(1) << MaxBits) - 1));
+
+    // The first two powers of two are exact
+    if ( value < quint64(SubBuckets) * 2 ) {
+        return int(value);
+    }
+
+    int highestBit = 0;
+    while ( (value >> (highestBit + 1)) != 0 ) {
+        ++highestBit;
+    }
+
+    const int shift = highestBit - SubBucketBits;
+    return (shift + 1) * SubBuckets + int(value >> shift) - SubBuckets;
+}
+
+qint64 LatencyHistogram::bucketUpperBound(int bucket)
+{
+    if ( bucket < SubBuckets * 2 ) {
+        return bucket;
+    }
+
+    const int shift = bucket / SubBuckets - 1;
+    const qint64 subBucket = bucket % SubBuckets + SubBuckets;
+    return ((subBucket + 1) << shift) - 1;
+}
+
+void LatencyHistogram::record(qint64 microseconds)
+{
+    ++m_buckets[bucketOf(microseconds)];
+
+    for (int i = 0; i < FixedBoundCount; ++i) {
+        if ( microseconds <= FixedBounds[i] ) {
+            ++m_fixedBoundCounts[i];
+            break;
+        }
+    }
+
+    ++m_count;
+    m_sum += microseconds;
+    m_min = qMin(m_min, microseconds);
+    m_max = qMax(m_max, microseconds);
+}
+
+void LatencyHistogram::merge(const LatencyHistogram & other)
+{
+    for (int i = 0; i < BucketCount; ++i) {
+        m_buckets[i] += other.m_buckets.at(i);
+    }
+
+    for (int i = 0; i < FixedBoundCount; ++i) {
+        m_fixedBoundCounts[i] += other.m_fixedBoundCounts.at(i);
+    }
+
+    m_count += other.m_count;
+    m_sum += other.m_sum;
+    m_min = qMin(m_min, other.m_min);
+    m_max = qMax(m_max, other.m_max);
+}
+
+void LatencyHistogram::reset()
+{
+    *this = LatencyHistogram();
+}
+
+qint64 LatencyHistogram::count() const
+{
+    return m_count;
+}
+
+qint64 LatencyHistogram::min() const
+{
+    return (m_count == 0) ? 0 : m_min;
+}
+
+qint64 LatencyHistogram::max() const
+{
+    return m_max;
+}
+
+double LatencyHistogram::mean() const
+{
+    return (m_count == 0) ? 0.0 : double(m_sum) / m_count;
+}
+
+qint64 LatencyHistogram::sum() const
+{
+    return m_sum;
+}
+
+qint64 LatencyHistogram::percentile(double percentile) const
+{
+    if ( m_count == 0 ) {
+        return 0;
+    }
+
+    const qint64 rank = qMax(qint64(1), qint64(qBound(0.0, percentile, 100.0) / 100.0 * m_count + 0.5));
+
+    qint64 seen = 0;
+    for (int i = 0; i < BucketCount; ++i) {
+        seen += m_buckets.at(i);
+        if ( seen >= rank ) {
+            return qMin(bucketUpperBound(i), m_max);
+        }
+    }
+
+    return m_max;
+}
+
+qint64 LatencyHistogram::bucketCount(int bucket) const
+{
+    return m_buckets.value(bucket);
+}
+
+qint64 LatencyHistogram::fixedBoundCount(int bound) const
+{
+    return m_fixedBoundCounts.value(bound);
+}
+
+qint64 LatencyHistogram::fixedBound(int bound)
+{
+    return (bound >= 0 && bound < FixedBoundCount) ? FixedBounds[bound] : 0;
+}
+
+DriverStatistics::DriverStatistics() :
+    m_operations(int(Operation::OperationCount)),
+    m_inFlight(0)
+{
+}
+
+DriverStatistics::OperationStatistics DriverStatistics::operation(Operation operation) const
+{
+    return m_operations.value(int(operation));
+}
+
+QString DriverStatistics::operationName(Operation operation)
+{
+    switch (operation)
+    {
+        case Operation::DocumentGet:        return QStringLiteral("document_get");
+        case Operation::DocumentCreate:     return QStringLiteral("document_create");
+        case Operation::DocumentReplace:    return QStringLiteral("document_replace");
+        case Operation::DocumentPatch:      return QStringLiteral("document_patch");
+        case Operation::DocumentDelete:     return QStringLiteral("document_delete");
+        case Operation::DocumentHead:       return QStringLiteral("document_head");
+        case Operation::EdgeGet:            return QStringLiteral("edge_get");
+        case Operation::EdgeCreate:         return QStringLiteral("edge_create");
+        case Operation::EdgeReplace:        return QStringLiteral("edge_replace");
+        case Operation::EdgePatch:          return QStringLiteral("edge_patch");
+        case Operation::EdgeDelete:         return QStringLiteral("edge_delete");
+        case Operation::EdgeImport:         return QStringLiteral("edge_import");
+        case Operation::EdgesLookup:        return QStringLiteral("edges_lookup");
+        case Operation::CollectionGet:      return QStringLiteral("collection_get");
+        case Operation::CollectionCreate:   return QStringLiteral("collection_create");
+        case Operation::CollectionLoad:     return QStringLiteral("collection_load");
+        case Operation::CollectionDelete:   return QStringLiteral("collection_delete");
+        case Operation::CursorCreate:       return QStringLiteral("cursor_create");
+        case Operation::CursorNext:         return QStringLiteral("cursor_next");
+        case Operation::CursorDelete:       return QStringLiteral("cursor_delete");
+        case Operation::Explain:            return QStringLiteral("explain");
+        default:                            return QStringLiteral("unknown");
+    }
+}
+
+qint64 DriverStatistics::requests() const
+{
+    qint64 total = 0;
+    for ( const OperationStatistics & operation : m_operations ) total += operation.requests;
+    return total;
+}
+
+qint64 DriverStatistics::errors() const
+{
+    qint64 total = 0;
+    for ( const OperationStatistics & operation : m_operations ) total += operation.errors;
+    return total;
+}
+
+qint64 DriverStatistics::bytesSent() const
+{
+    qint64 total = 0;
+    for ( const OperationStatistics & operation : m_operations ) total += operation.bytesSent;
+    return total;
+}
+
+qint64 DriverStatistics::bytesReceived() const
+{
+    qint64 total = 0;
+    for ( const OperationStatistics & operation : m_operations ) total += operation.bytesReceived;
+    return total;
+}
+
+QHash<int, qint64> DriverStatistics::errorsByStatus() const
+{
+    return m_errorsByStatus;
+}
+
+int DriverStatistics::inFlight() const
+{
+    return m_inFlight;
+}
+
+LatencyHistogram DriverStatistics::latency() const
+{
+    LatencyHistogram histogram;
+    for ( const OperationStatistics & operation : m_operations ) {
+        histogram.merge(operation.latency);
+    }
+
+    return histogram;
+}
+
+void DriverStatistics::recordRequest(Operation operation, qint64 bytesSent)
+{
+    OperationStatistics & statistics = m_operations[int(operation)];
+    ++statistics.requests;
+    statistics.bytesSent += bytesSent;
+    ++m_inFlight;
+}
+
+void DriverStatistics::recordReply(Operation operation, int status, qint64 bytesReceived, qint64 microseconds)
+{
+    OperationStatistics & statistics = m_operations[int(operation)];
+    statistics.bytesReceived += bytesReceived;
+    statistics.latency.record(microseconds);
+
+    if ( status == 0 || status >= 400 ) {
+        ++statistics.errors;
+        ++m_errorsByStatus[status];
+    }
+
+    m_inFlight = qMax(m_inFlight - 1, 0);
+}
+
+void DriverStatistics::reset()
+{
+    const int inFlight = m_inFlight;
+    *this = DriverStatistics();
+    m_inFlight = inFlight;
+}
+
+}
@@ -0,0 +1,405 @@
+/********************************************************************************
+ ** The MIT License (MIT)
+ **
+ ** Copyright (c) 2013 Sascha Ludwig Häusler
+ **
+ ** Permission is hereby granted, free of charge, to any person obtaining a copy of
+ ** this software and associated documentation files (the "Software"), to deal in
+ ** the Software without restriction, including without limitation the rights to
+ ** use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ ** the Software, and to permit persons to whom the Software is furnished to do so,
+ ** subject to the following conditions:
+ **
+ ** The above copyright notice and this permission notice shall be included in all
+ ** copies or substantial portions of the Software.
+ **
+ ** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ ** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ ** FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ ** COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ ** IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ ** CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *********************************************************************************/
+
+#ifndef DRIVERSTATISTICS_H
+#define DRIVERSTATISTICS_H
+
+#include "arangodb-driver_global.h"
+
+#include <QtCore/QHash>
+#include <QtCore/QString>
+#include <QtCore/QVector>
+
+namespace arangodb
+{
+
+/**
+ * @brief Histogram of latencies in microseconds with log-linear
+ * buckets: every power of two is split into 16 buckets, so any
+ * recorded value is off by at most 1/16 while the whole range
+ * up to 2^40 microseconds fits into 608 counters. Recording
+ * a value is a few shifts and one increment.
+ *
+ * @since 0.6
+ */
+class ARANGODBDRIVERSHARED_EXPORT LatencyHistogram
+{
+    public:
+        /**
+         * @brief LatencyHistogram
+         *
+         * @since 0.6
+         */
+        LatencyHistogram();
+
+        /**
+         * @brief record
+         *
+         * @param microseconds
+         *
+         * @since 0.6
+         */
+        void record(qint64 microseconds);
+
+        /**
+         * @brief Adds all values of the other histogram
+         *
+         * @param other
+         *
+         * @since 0.6
+         */
+        void merge(const LatencyHistogram & other);
+
+        /**
+         * @brief reset
+         *
+         * @since 0.6
+         */
+        void reset();
+
+        /**
+         * @brief count
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        qint64 count() const;
+
+        /**
+         * @brief min
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        qint64 min() const;
+
+        /**
+         * @brief max
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        qint64 max() const;
+
+        /**
+         * @brief mean
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        double mean() const;
+
+        /**
+         * @brief Returns the sum of all recorded values
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        qint64 sum() const;
+
+        /**
+         * @brief Returns the value below which the given
+         * percentage (0 to 100) of all values lie
+         *
+         * @param percentile
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        qint64 percentile(double percentile) const;
+
+        /**
+         * @brief Returns the number of values in the bucket
+         *
+         * @param bucket
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        qint64 bucketCount(int bucket) const;
+
+        /**
+         * @brief Returns the highest value which
+         * falls into the bucket
+         *
+         * @param bucket
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        static qint64 bucketUpperBound(int bucket);
+
+        /**
+         * @brief bucketOf
+         *
+         * @param microseconds
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        static int bucketOf(qint64 microseconds);
+
+        /**
+         * @brief Returns the number of values above the previous
+         * fixed bound up to and including this one. Unlike the
+         * buckets they are counted exactly, values above the
+         * last fixed bound are not counted.
+         *
+         * @param bound
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        qint64 fixedBoundCount(int bound) const;
+
+        /**
+         * @brief Returns the fixed bound in microseconds, they are
+         * the usual Prometheus buckets from 0.5ms to 10s
+         *
+         * @param bound
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        static qint64 fixedBound(int bound);
+
+        static const int FixedBoundCount = 14;
+
+        static const int SubBucketBits = 4;
+        static const int SubBuckets = 1 << SubBucketBits;
+        static const int MaxBits = 40;
+        static const int BucketCount = (MaxBits - SubBucketBits + 2) * SubBuckets;
+
+    private:
+        QVector<qint64> m_buckets;
+        QVector<qint64> m_fixedBoundCounts;
+        qint64 m_count;
+        qint64 m_sum;
+        qint64 m_min;
+        qint64 m_max;
+};
+
+/**
+ * @brief Snapshot of the requests sent by a driver
+ * (see Arangodbdriver::statistics)
+ *
+ * @since 0.6
+ */
+class ARANGODBDRIVERSHARED_EXPORT DriverStatistics
+{
+    public:
+        /**
+         * @brief The kind of request
+         *
+         * @since 0.6
+         */
+        enum class Operation : quint8 {
+            DocumentGet         = 0,
+            DocumentCreate      = 1,
+            DocumentReplace     = 2,
+            DocumentPatch       = 3,
+            DocumentDelete      = 4,
+            DocumentHead        = 5,
+            EdgeGet             = 6,
+            EdgeCreate          = 7,
+            EdgeReplace         = 8,
+            EdgePatch           = 9,
+            EdgeDelete          = 10,
+            EdgeImport          = 11,
+            EdgesLookup         = 12,
+            CollectionGet       = 13,
+            CollectionCreate    = 14,
+            CollectionLoad      = 15,
+            CollectionDelete    = 16,
+            CursorCreate        = 17,
+            CursorNext          = 18,
+            CursorDelete        = 19,
+            Explain             = 20,
+            OperationCount      = 21
+        };
+
+        /**
+         * @brief Counters of one kind of request
+         *
+         * @since 0.6
+         */
+        struct OperationStatistics {
+                qint64 requests = 0;
+                qint64 errors = 0;
+                qint64 bytesSent = 0;
+                qint64 bytesReceived = 0;
+
+                /**
+                 * @brief time from sending the request until
+                 * the whole reply was received
+                 *
+                 * @since 0.6
+                 */
+                LatencyHistogram latency;
+        };
+
+        /**
+         * @brief DriverStatistics
+         *
+         * @since 0.6
+         */
+        DriverStatistics();
+
+        /**
+         * @brief operation
+         *
+         * @param operation
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        OperationStatistics operation(Operation operation) const;
+
+        /**
+         * @brief Returns a name like "document_get"
+         *
+         * @param operation
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        static QString operationName(Operation operation);
+
+        /**
+         * @brief Returns the number of requests of all operations
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        qint64 requests() const;
+
+        /**
+         * @brief errors
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        qint64 errors() const;
+
+        /**
+         * @brief bytesSent
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        qint64 bytesSent() const;
+
+        /**
+         * @brief bytesReceived
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        qint64 bytesReceived() const;
+
+        /**
+         * @brief Returns the number of failed requests per HTTP
+         * status code, 0 stands for network errors without a reply
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        QHash<int, qint64> errorsByStatus() const;
+
+        /**
+         * @brief Returns the number of requests which
+         * have been sent but not yet answered
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        int inFlight() const;
+
+        /**
+         * @brief Returns the latencies of all operations together
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        LatencyHistogram latency() const;
+
+        /**
+         * @brief Called by the driver when a request is sent
+         *
+         * @param operation
+         * @param bytesSent
+         *
+         * @since 0.6
+         */
+        void recordRequest(Operation operation, qint64 bytesSent);
+
+        /**
+         * @brief Called by the driver when a reply is finished,
+         * a status of 400 or above counts as error
+         *
+         * @param operation
+         * @param status
+         * @param bytesReceived
+         * @param microseconds
+         *
+         * @since 0.6
+         */
+        void recordReply(Operation operation, int status, qint64 bytesReceived, qint64 microseconds);
+
+        /**
+         * @brief Sets all counters back to 0, requests
+         * in flight stay counted
+         *
+         * @since 0.6
+         */
+        void reset();
+
+    private:
+        QVector<OperationStatistics> m_operations;
+        QHash<int, qint64> m_errorsByStatus;
+        int m_inFlight;
+};
+
+}
+
+#endif // DRIVERSTATISTICS_H
@@ -33,9 +33,6 @@ class EdgePrivate : public DocumentPrivate
     public:
 };
 
-const QString FROM  = QStringLiteral("_from");
-const QString TO = QStringLiteral("_to");
-
 }
 
 Edge::Edge(QObject *parent) :
@@ -46,8 +43,8 @@ Edge::Edge(QObject *parent) :
 Edge::Edge(QString collection, Document *fromDoc, Document *toDoc, QObject *parent) :
     Document(new internal::EdgePrivate, collection, parent)
 {
-    d_func()->data.insert(internal::FROM, fromDoc->docID());
-    d_func()->data.insert(internal::TO, toDoc->docID());
+    d_func()->insert(internal::FROM, fromDoc->docID());
+    d_func()->insert(internal::TO, toDoc->docID());
 }
 
 QString Edge::from()
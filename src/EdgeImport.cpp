@@ -0,0 +1,303 @@
+/********************************************************************************
+ ** The MIT License (MIT)
+ **
+ ** Copyright (c) 2013 Sascha Ludwig Häusler
+ **
+ ** Permission is hereby granted, free of charge, to any person obtaining a copy of
+ ** this software and associated documentation files (the "Software"), to deal in
+ ** the Software without restriction, including without limitation the rights to
+ ** use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ ** the Software, and to permit persons to whom the Software is furnished to do so,
+ ** subject to the following conditions:
+ **
+ ** The above copyright notice and this permission notice shall be included in all
+ ** copies or substantial portions of the Software.
+ **
+ ** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ ** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ ** FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ ** COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ ** IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ ** CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *********************************************************************************/
+
+#include "EdgeImport.h"
+
+#include <QtCore/QDebug>
+#include <QtCore/QEventLoop>
+#include <QtCore/QHash>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QPointer>
+#include <QtCore/QQueue>
+#include <QtCore/QSet>
+#include <QtCore/QTimer>
+#include <QtCore/QVariant>
+#include <QtNetwork/QNetworkReply>
+
+namespace arangodb
+{
+
+class EdgeImportPrivate
+{
+    public:
+        QString collection;
+        int chunkSize;
+        int maxRunningChunks = 2;
+        int maxPendingChunks = 0;
+
+        QByteArray currentChunk;
+        int currentChunkEdges = 0;
+
+        bool isCollectingVertices = true;
+        QSet<QString> currentChunkVertices;
+
+        struct Chunk {
+            int number;
+            int edges;
+            QByteArray body;
+            QStringList vertices;
+        };
+
+        QQueue<Chunk> queue;
+        QHash<int, int> runningChunks;
+        int nextChunk = 0;
+
+        qint64 created = 0;
+        qint64 errors = 0;
+
+        bool isFinishing = false;
+        bool isFinished = false;
+
+        inline bool isFull() const {
+            return maxPendingChunks > 0 && queue.size() >= maxPendingChunks;
+        }
+
+        inline void closeChunk() {
+            if ( currentChunkEdges == 0 ) return;
+
+            queue.enqueue({nextChunk++, currentChunkEdges, currentChunk, currentChunkVertices.toList()});
+            currentChunk.clear();
+            currentChunkEdges = 0;
+            currentChunkVertices.clear();
+        }
+};
+
+EdgeImport::EdgeImport(const QString & collection, int chunkSize, QObject * parent) :
+    QObject(parent),
+    d_ptr(new EdgeImportPrivate)
+{
+    Q_D(EdgeImport);
+    d->collection = collection;
+    d->chunkSize = qMax(chunkSize, 1);
+}
+
+EdgeImport::~EdgeImport()
+{
+    delete d_ptr;
+}
+
+QString EdgeImport::collection() const
+{
+    Q_D(const EdgeImport);
+    return d->collection;
+}
+
+int EdgeImport::chunkSize() const
+{
+    Q_D(const EdgeImport);
+    return d->chunkSize;
+}
+
+void EdgeImport::setMaxRunningChunks(int chunks)
+{
+    Q_D(EdgeImport);
+    d->maxRunningChunks = qMax(chunks, 1);
+}
+
+int EdgeImport::maxRunningChunks() const
+{
+    Q_D(const EdgeImport);
+    return d->maxRunningChunks;
+}
+
+void EdgeImport::setMaxPendingChunks(int chunks)
+{
+    Q_D(EdgeImport);
+    d->maxPendingChunks = qMax(chunks, 0);
+}
+
+int EdgeImport::maxPendingChunks() const
+{
+    Q_D(const EdgeImport);
+    return d->maxPendingChunks;
+}
+
+bool EdgeImport::isFull() const
+{
+    Q_D(const EdgeImport);
+    return d->isFull();
+}
+
+bool EdgeImport::addEdge(const QString & from, const QString & to, const QJsonObject & attributes)
+{
+    Q_D(EdgeImport);
+
+    if ( d->isFinishing ) {
+        qWarning() << Q_FUNC_INFO;
+        qWarning() << "Edge import is already finished";
+        return false;
+    }
+
+    // The current chunk is closed as soon as it is full,
+    // so the queue never grows beyond its maximum
+    if ( d->isFull() ) {
+        return false;
+    }
+
+    QJsonObject edge = attributes;
+    edge.insert(QStringLiteral("_from"), from);
+    edge.insert(QStringLiteral("_to"), to);
+
+    d->currentChunk.append(QJsonDocument(edge).toJson(QJsonDocument::Compact));
+    d->currentChunk.append('\n');
+    ++d->currentChunkEdges;
+    if ( d->isCollectingVertices ) {
+        d->currentChunkVertices.insert(from);
+        d->currentChunkVertices.insert(to);
+    }
+
+    if ( d->currentChunkEdges >= d->chunkSize ) {
+        d->closeChunk();
+        sendNextChunks();
+    }
+
+    return true;
+}
+
+void EdgeImport::finish()
+{
+    Q_D(EdgeImport);
+
+    if ( d->isFinishing ) {
+        return;
+    }
+
+    d->isFinishing = true;
+    d->closeChunk();
+    sendNextChunks();
+}
+
+int EdgeImport::pendingChunks() const
+{
+    Q_D(const EdgeImport);
+    return d->queue.size();
+}
+
+qint64 EdgeImport::created() const
+{
+    Q_D(const EdgeImport);
+    return d->created;
+}
+
+qint64 EdgeImport::errors() const
+{
+    Q_D(const EdgeImport);
+    return d->errors;
+}
+
+bool EdgeImport::isFinished() const
+{
+    Q_D(const EdgeImport);
+    return d->isFinished;
+}
+
+bool EdgeImport::waitUntilFinished(int msecs)
+{
+    Q_D(EdgeImport);
+
+    if ( d->isFinished ) {
+        return true;
+    }
+
+    // The last chunk is only sent by finish()
+    if ( !d->isFinishing ) {
+        qWarning() << Q_FUNC_INFO;
+        qWarning() << "Edge import is not finishing";
+        return false;
+    }
+
+    QPointer<EdgeImport> self(this);
+
+    QEventLoop loop;
+    QObject::connect( this, &EdgeImport::finished, &loop, &QEventLoop::quit );
+    QObject::connect( this, &QObject::destroyed, &loop, &QEventLoop::quit );
+    if ( msecs >= 0 ) {
+        QTimer::singleShot(msecs, &loop, &QEventLoop::quit);
+    }
+    loop.exec();
+
+    return self && self->isFinished();
+}
+
+void EdgeImport::_ar_chunk_imported()
+{
+    Q_D(EdgeImport);
+
+    QNetworkReply *reply = qobject_cast<QNetworkReply *>(sender());
+    QJsonObject obj = QJsonDocument::fromJson(reply->readAll()).object();
+    const int chunk = reply->property("_ar_chunk").toInt();
+    reply->deleteLater();
+
+    const int edges = d->runningChunks.take(chunk);
+
+    if ( obj.value(QStringLiteral("error")).toBool() || obj.isEmpty() ) {
+        d->errors += edges;
+
+        QString errorMessage = obj.value(QStringLiteral("errorMessage")).toString();
+        if ( errorMessage.isEmpty() ) errorMessage = reply->errorString();
+
+        emit chunkError(chunk, errorMessage);
+    }
+    else {
+        const int created = obj.value(QStringLiteral("created")).toInt();
+        const int errors = obj.value(QStringLiteral("errors")).toInt();
+
+        QStringList details;
+        for ( const QJsonValue & detail : obj.value(QStringLiteral("details")).toArray() ) {
+            details.append(detail.toString());
+        }
+
+        d->created += created;
+        d->errors += errors;
+
+        emit chunkImported(chunk, created, errors, details);
+    }
+
+    sendNextChunks();
+}
+
+void EdgeImport::setCollectingVertices(bool collecting)
+{
+    Q_D(EdgeImport);
+    d->isCollectingVertices = collecting;
+}
+
+void EdgeImport::sendNextChunks()
+{
+    Q_D(EdgeImport);
+
+    while ( !d->queue.isEmpty() && d->runningChunks.size() < d->maxRunningChunks ) {
+        EdgeImportPrivate::Chunk chunk = d->queue.dequeue();
+        d->runningChunks.insert(chunk.number, chunk.edges);
+
+        emit sendChunk(this, chunk.number, chunk.body, chunk.vertices);
+    }
+
+    if ( d->isFinishing && !d->isFinished && d->queue.isEmpty() && d->runningChunks.isEmpty() ) {
+        d->isFinished = true;
+        emit finished();
+    }
+}
+
+}
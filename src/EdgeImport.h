@@ -0,0 +1,293 @@
+/********************************************************************************
+ ** The MIT License (MIT)
+ **
+ ** Copyright (c) 2013 Sascha Ludwig Häusler
+ **
+ ** Permission is hereby granted, free of charge, to any person obtaining a copy of
+ ** this software and associated documentation files (the "Software"), to deal in
+ ** the Software without restriction, including without limitation the rights to
+ ** use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ ** the Software, and to permit persons to whom the Software is furnished to do so,
+ ** subject to the following conditions:
+ **
+ ** The above copyright notice and this permission notice shall be included in all
+ ** copies or substantial portions of the Software.
+ **
+ ** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ ** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ ** FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ ** COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ ** IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ ** CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *********************************************************************************/
+
+#ifndef EDGEIMPORT_H
+#define EDGEIMPORT_H
+
+#include "arangodb-driver_global.h"
+
+#include <QtCore/QJsonObject>
+#include <QtCore/QObject>
+#include <QtCore/QStringList>
+
+namespace arangodb
+{
+
+class Arangodbdriver;
+class EdgeImportPrivate;
+
+/**
+ * @brief Creates edges in bulk through the import API. The edges
+ * are given as document ids of both vertices and are collected
+ * into chunks of JSON lines, every full chunk is sent as one
+ * request. Only a few chunks are sent at the same time, the
+ * others wait in a queue (see pendingChunks), which can be
+ * bounded with setMaxPendingChunks.
+ *
+ * Created by Arangodbdriver::createEdgeImport.
+ *
+ * @since 0.6
+ */
+class ARANGODBDRIVERSHARED_EXPORT EdgeImport : public QObject
+{
+        Q_OBJECT
+    public:
+        /**
+         * @brief EdgeImport
+         *
+         * @param collection    Edge collection
+         * @param chunkSize     Number of edges per request
+         * @param parent
+         *
+         * @since 0.6
+         */
+        EdgeImport(const QString & collection, int chunkSize = 10000, QObject * parent = 0);
+
+        /**
+         * @brief ~EdgeImport
+         *
+         * @since 0.6
+         */
+        virtual ~EdgeImport();
+
+        /**
+         * @brief collection
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        QString collection() const;
+
+        /**
+         * @brief chunkSize
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        int chunkSize() const;
+
+        /**
+         * @brief Sets how many chunks are sent at the same
+         * time, the default is 2
+         *
+         * @param chunks
+         *
+         * @since 0.6
+         */
+        void setMaxRunningChunks(int chunks);
+
+        /**
+         * @brief maxRunningChunks
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        int maxRunningChunks() const;
+
+        /**
+         * @brief Sets how many full chunks may wait to be sent,
+         * addEdge rejects edges while the queue is full. The
+         * default 0 does not bound the queue.
+         *
+         * @param chunks
+         *
+         * @since 0.6
+         */
+        void setMaxPendingChunks(int chunks);
+
+        /**
+         * @brief maxPendingChunks
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        int maxPendingChunks() const;
+
+        /**
+         * @brief Returns true while the queue of chunks waiting
+         * to be sent is at its maximum (see setMaxPendingChunks)
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        bool isFull() const;
+
+        /**
+         * @brief Adds an edge from one vertex to another, a full
+         * chunk is sent right away. While the queue is full (see
+         * isFull) the edge is not added, it can be added again
+         * once the event loop delivered chunkImported or chunkError.
+         *
+         * @param from          Document id of the start vertex
+         * @param to            Document id of the end vertex
+         * @param attributes
+         *
+         * @return false if the edge was not added
+         *
+         * @since 0.6
+         */
+        bool addEdge(const QString & from, const QString & to, const QJsonObject & attributes = QJsonObject());
+
+        /**
+         * @brief Sends the last chunk, finished is emitted once
+         * every chunk has been imported. No edges can be
+         * added afterwards.
+         *
+         * @since 0.6
+         */
+        void finish();
+
+        /**
+         * @brief Returns the number of full chunks which
+         * wait to be sent
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        int pendingChunks() const;
+
+        /**
+         * @brief Returns the number of edges created so far
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        qint64 created() const;
+
+        /**
+         * @brief Returns the number of edges which could not be
+         * created so far, including all edges of failed chunks
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        qint64 errors() const;
+
+        /**
+         * @brief isFinished
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        bool isFinished() const;
+
+        /**
+         * @brief Waits until all chunks have been imported. Returns
+         * right away if finish() has not been called, and stops
+         * waiting after msecs or if the import is destroyed.
+         *
+         * @param msecs     -1 waits without a timeout
+         *
+         * @return true if the import is finished
+         *
+         * @since 0.6
+         */
+        bool waitUntilFinished(int msecs = -1);
+
+    public Q_SLOTS:
+        /**
+         * @brief _ar_chunk_imported
+         *
+         * @since 0.6
+         */
+        void _ar_chunk_imported();
+
+    Q_SIGNALS:
+        /**
+         * @brief Emitted for every chunk which has to be sent,
+         * handled by the driver
+         *
+         * @param import
+         * @param chunk
+         * @param body
+         * @param vertices  _from and _to of all edges in the chunk,
+         *                  empty if the adjacency cache of the driver
+         *                  was disabled when the import was created
+         *
+         * @since 0.6
+         */
+        void sendChunk(EdgeImport * import, int chunk, const QByteArray & body, const QStringList & vertices);
+
+        /**
+         * @brief Emitted for every chunk the server has imported,
+         * details contains the messages of the edges which
+         * could not be created
+         *
+         * @param chunk
+         * @param created
+         * @param errors
+         * @param details
+         *
+         * @since 0.6
+         */
+        void chunkImported(int chunk, int created, int errors, const QStringList & details);
+
+        /**
+         * @brief Emitted if the server rejected a whole chunk
+         *
+         * @param chunk
+         * @param errorMessage
+         *
+         * @since 0.6
+         */
+        void chunkError(int chunk, const QString & errorMessage);
+
+        /**
+         * @brief finished
+         *
+         * @since 0.6
+         */
+        void finished();
+
+    protected:
+        EdgeImportPrivate *d_ptr;
+
+    private:
+        friend class Arangodbdriver;
+        Q_DECLARE_PRIVATE(EdgeImport)
+
+        /**
+         * @brief The vertices of a chunk are only collected
+         * for the adjacency cache of the driver
+         *
+         * @param collecting
+         *
+         * @since 0.6
+         */
+        void setCollectingVertices(bool collecting);
+
+        void sendNextChunks();
+};
+
+}
+
+#endif // EDGEIMPORT_H
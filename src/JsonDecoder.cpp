@@ -0,0 +1,143 @@
+/********************************************************************************
+ ** The MIT License (MIT)
+ **
+ ** Copyright (c) 2013 Sascha Ludwig Häusler
+ **
+ ** Permission is hereby granted, free of charge, to any person obtaining a copy of
+ ** this software and associated documentation files (the "Software"), to deal in
+ ** the Software without restriction, including without limitation the rights to
+ ** use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ ** the Software, and to permit persons to whom the Software is furnished to do so,
+ ** subject to the following conditions:
+ **
+ ** The above copyright notice and this permission notice shall be included in all
+ ** copies or substantial portions of the Software.
+ **
+ ** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ ** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ ** FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ ** COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ ** IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ ** CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *********************************************************************************/
+
+#include "private/JsonDecoder_p.h"
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QEvent>
+#include <QtCore/QMutex>
+#include <QtCore/QRunnable>
+#include <QtCore/QThreadPool>
+
+namespace internal {
+
+namespace {
+
+const QEvent::Type DecodedEventType = QEvent::Type(QEvent::registerEventType());
+
+class DecodedEvent : public QEvent
+{
+    public:
+        explicit DecodedEvent(const QJsonDocument & document) :
+            QEvent(DecodedEventType),
+            document(document)
+        {
+        }
+
+        QJsonDocument document;
+};
+
+}
+
+/**
+ * @brief Shared by the decoder and the pool. The receiver is
+ * only read and reset under the mutex, so the event is either
+ * posted before the decoder is deleted, and removed with it,
+ * or not at all.
+ */
+class JsonDecodeTask
+{
+    public:
+        JsonDecodeTask(QObject * receiver, const QByteArray & data) :
+            receiver(receiver),
+            data(data)
+        {
+        }
+
+        void decode() {
+            const QJsonDocument document = QJsonDocument::fromJson(data);
+            data.clear();
+
+            QMutexLocker locker(&mutex);
+            if ( receiver != nullptr ) {
+                QCoreApplication::postEvent(receiver, new DecodedEvent(document));
+            }
+        }
+
+        void cancel() {
+            QMutexLocker locker(&mutex);
+            receiver = nullptr;
+        }
+
+    private:
+        QMutex mutex;
+        QObject * receiver;
+        QByteArray data;
+};
+
+namespace {
+
+/**
+ * @brief Owned by the pool, keeps the task alive
+ * even if the decoder is deleted meanwhile
+ */
+class JsonDecodeRunnable : public QRunnable
+{
+    public:
+        explicit JsonDecodeRunnable(std::shared_ptr<JsonDecodeTask> task) :
+            m_task(std::move(task))
+        {
+        }
+
+        void run() override {
+            m_task->decode();
+        }
+
+    private:
+        std::shared_ptr<JsonDecodeTask> m_task;
+};
+
+}
+
+JsonDecoder::JsonDecoder(QObject * context, std::function<void(const QJsonDocument &)> callback) :
+    QObject(context),
+    m_callback(std::move(callback))
+{
+}
+
+JsonDecoder::~JsonDecoder()
+{
+    if ( m_task ) {
+        m_task->cancel();
+    }
+}
+
+void JsonDecoder::start(QThreadPool * pool, const QByteArray & data)
+{
+    m_task = std::make_shared<JsonDecodeTask>(this, data);
+    pool->start(new JsonDecodeRunnable(m_task));
+}
+
+bool JsonDecoder::event(QEvent * event)
+{
+    if ( event->type() == DecodedEventType ) {
+        m_task.reset();
+        m_callback(static_cast<DecodedEvent *>(event)->document);
+        deleteLater();
+        return true;
+    }
+
+    return QObject::event(event);
+}
+
+}
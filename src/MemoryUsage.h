@@ -0,0 +1,97 @@
+/********************************************************************************
+ ** The MIT License (MIT)
+ **
+ ** Copyright (c) 2013 Sascha Ludwig Häusler
+ **
+ ** Permission is hereby granted, free of charge, to any person obtaining a copy of
+ ** this software and associated documentation files (the "Software"), to deal in
+ ** the Software without restriction, including without limitation the rights to
+ ** use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ ** the Software, and to permit persons to whom the Software is furnished to do so,
+ ** subject to the following conditions:
+ **
+ ** The above copyright notice and this permission notice shall be included in all
+ ** copies or substantial portions of the Software.
+ **
+ ** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ ** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ ** FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ ** COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ ** IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ ** CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *********************************************************************************/
+
+#ifndef MEMORYUSAGE_H
+#define MEMORYUSAGE_H
+
+#include "arangodb-driver_global.h"
+
+#include <QtCore/QtGlobal>
+
+namespace arangodb
+{
+
+/**
+ * @brief Approximate memory held by the driver in bytes
+ * (see Arangodbdriver::memoryUsage). The sizes are estimated
+ * from the number and length of the stored values, the real
+ * allocations may differ by some ten percent.
+ *
+ * Documents and cursors are counted for the whole process,
+ * no matter which driver created them.
+ *
+ * @since 0.6
+ */
+struct ARANGODBDRIVERSHARED_EXPORT MemoryUsage {
+        /**
+         * @brief object overhead of all living Document's and,
+         * while a driver has a soft limit, the attributes set on
+         * them. Rows of cursors are counted in cursorBatches.
+         *
+         * @since 0.6
+         */
+        qint64 documents = 0;
+
+        /**
+         * @brief number of living Document's
+         *
+         * @since 0.6
+         */
+        qint64 documentCount = 0;
+
+        /**
+         * @brief reply size of the batches loaded by living
+         * cursors, rows and columns included
+         *
+         * @since 0.6
+         */
+        qint64 cursorBatches = 0;
+
+        /**
+         * @brief request bodies and received reply data
+         * of the running requests of the driver
+         *
+         * @since 0.6
+         */
+        qint64 requestBuffers = 0;
+
+        /**
+         * @brief caches of the driver
+         *
+         * @since 0.6
+         */
+        qint64 caches = 0;
+
+        /**
+         * @brief Returns the sum of all values
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        qint64 total() const;
+};
+
+}
+
+#endif // MEMORYUSAGE_H
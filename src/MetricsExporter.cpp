@@ -0,0 +1,286 @@
+/********************************************************************************
+ ** The MIT License (MIT)
+ **
+ ** Copyright (c) 2013 Sascha Ludwig Häusler
+ **
+ ** Permission is hereby granted, free of charge, to any person obtaining a copy of
+ ** this software and associated documentation files (the "Software"), to deal in
+ ** the Software without restriction, including without limitation the rights to
+ ** use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ ** the Software, and to permit persons to whom the Software is furnished to do so,
+ ** subject to the following conditions:
+ **
+ ** The above copyright notice and this permission notice shall be included in all
+ ** copies or substantial portions of the Software.
+ **
+ ** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ ** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ ** FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ ** COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ ** IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ ** CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *********************************************************************************/
+
+#include "MetricsExporter.h"
+#include "Arangodbdriver.h"
+
+#include <QtCore/QPointer>
+#include <QtNetwork/QTcpServer>
+#include <QtNetwork/QTcpSocket>
+
+namespace arangodb
+{
+
+namespace {
+
+const int MaxRequestSize = 8192;
+
+inline QByteArray seconds(qint64 microseconds)
+{
+    return QByteArray::number(microseconds / 1000000.0, 'g', 12);
+}
+
+inline void family(QByteArray & out, const char * name, const char * type, const char * help)
+{
+    out += QByteArrayLiteral("# TYPE ") + name + ' ' + type + '\n';
+    out += QByteArrayLiteral("# HELP ") + name + ' ' + help + '\n';
+}
+
+inline void sample(QByteArray & out, const QByteArray & name, const QByteArray & labels, const QByteArray & value)
+{
+    out += name;
+    if ( !labels.isEmpty() ) out += '{' + labels + '}';
+    out += ' ' + value + '\n';
+}
+
+}
+
+class MetricsExporterPrivate
+{
+    public:
+        QPointer<Arangodbdriver> driver;
+        QTcpServer * server = nullptr;
+};
+
+const QByteArray MetricsExporter::ContentType =
+        QByteArrayLiteral("application/openmetrics-text; version=1.0.0; charset=utf-8");
+
+MetricsExporter::MetricsExporter(Arangodbdriver * driver, QObject * parent) :
+    QObject(parent),
+    d_ptr(new MetricsExporterPrivate)
+{
+    Q_D(MetricsExporter);
+    d->driver = driver;
+}
+
+MetricsExporter::~MetricsExporter()
+{
+    delete d_ptr;
+}
+
+QByteArray MetricsExporter::render() const
+{
+    Q_D(const MetricsExporter);
+
+    QByteArray out;
+    if ( d->driver.isNull() ) {
+        out += QByteArrayLiteral("# EOF\n");
+        return out;
+    }
+
+    const DriverStatistics statistics = d->driver->statistics();
+    const int operationCount = int(DriverStatistics::Operation::OperationCount);
+
+    // Operations without any request are left out
+    QVector<DriverStatistics::Operation> operations;
+    QVector<QByteArray> labels;
+    for (int i = 0; i < operationCount; ++i) {
+        auto operation = DriverStatistics::Operation(i);
+        if ( statistics.operation(operation).requests == 0 ) continue;
+
+        operations << operation;
+        labels << QByteArrayLiteral("operation=\"") + DriverStatistics::operationName(operation).toLatin1() + '"';
+    }
+
+    family(out, "arangodb_driver_requests", "counter", "Requests sent to the server.");
+    for (int i = 0; i < operations.size(); ++i) {
+        sample(out, "arangodb_driver_requests_total", labels.at(i),
+               QByteArray::number(statistics.operation(operations.at(i)).requests));
+    }
+
+    family(out, "arangodb_driver_request_errors", "counter", "Requests which failed or were answered with a status of 400 or above.");
+    for (int i = 0; i < operations.size(); ++i) {
+        sample(out, "arangodb_driver_request_errors_total", labels.at(i),
+               QByteArray::number(statistics.operation(operations.at(i)).errors));
+    }
+
+    family(out, "arangodb_driver_sent_bytes", "counter", "Bytes of request bodies.");
+    out += QByteArrayLiteral("# UNIT arangodb_driver_sent_bytes bytes\n");
+    for (int i = 0; i < operations.size(); ++i) {
+        sample(out, "arangodb_driver_sent_bytes_total", labels.at(i),
+               QByteArray::number(statistics.operation(operations.at(i)).bytesSent));
+    }
+
+    family(out, "arangodb_driver_received_bytes", "counter", "Bytes of reply bodies.");
+    out += QByteArrayLiteral("# UNIT arangodb_driver_received_bytes bytes\n");
+    for (int i = 0; i < operations.size(); ++i) {
+        sample(out, "arangodb_driver_received_bytes_total", labels.at(i),
+               QByteArray::number(statistics.operation(operations.at(i)).bytesReceived));
+    }
+
+    // The fixed bounds of the histogram are counted exactly
+    family(out, "arangodb_driver_request_duration_seconds", "histogram", "Time from sending a request until its reply was received.");
+    out += QByteArrayLiteral("# UNIT arangodb_driver_request_duration_seconds seconds\n");
+    for (int i = 0; i < operations.size(); ++i) {
+        const LatencyHistogram & latency = statistics.operation(operations.at(i)).latency;
+
+        qint64 cumulative = 0;
+        for (int bound = 0; bound < LatencyHistogram::FixedBoundCount; ++bound) {
+            cumulative += latency.fixedBoundCount(bound);
+            sample(out, "arangodb_driver_request_duration_seconds_bucket",
+                   labels.at(i) + ",le=\"" + seconds(LatencyHistogram::fixedBound(bound)) + '"',
+                   QByteArray::number(cumulative));
+        }
+        sample(out, "arangodb_driver_request_duration_seconds_bucket",
+               labels.at(i) + ",le=\"+Inf\"", QByteArray::number(latency.count()));
+        sample(out, "arangodb_driver_request_duration_seconds_count", labels.at(i),
+               QByteArray::number(latency.count()));
+        sample(out, "arangodb_driver_request_duration_seconds_sum", labels.at(i),
+               seconds(latency.sum()));
+    }
+
+    family(out, "arangodb_driver_in_flight_requests", "gauge",
+           "Requests waiting in the network queue or for their reply.");
+    sample(out, "arangodb_driver_in_flight_requests", QByteArray(), QByteArray::number(statistics.inFlight()));
+
+    family(out, "arangodb_driver_open_cursors", "gauge", "Cursors which are still open on the server.");
+    sample(out, "arangodb_driver_open_cursors", QByteArray(), QByteArray::number(d->driver->openCursorCount()));
+
+    const MemoryUsage memory = d->driver->memoryUsage();
+    family(out, "arangodb_driver_memory_bytes", "gauge", "Approximate memory held by documents, cursors, running requests and caches.");
+    out += QByteArrayLiteral("# UNIT arangodb_driver_memory_bytes bytes\n");
+    sample(out, "arangodb_driver_memory_bytes", "area=\"documents\"", QByteArray::number(memory.documents));
+    sample(out, "arangodb_driver_memory_bytes", "area=\"cursor_batches\"", QByteArray::number(memory.cursorBatches));
+    sample(out, "arangodb_driver_memory_bytes", "area=\"request_buffers\"", QByteArray::number(memory.requestBuffers));
+    sample(out, "arangodb_driver_memory_bytes", "area=\"caches\"", QByteArray::number(memory.caches));
+
+    const AdjacencyCache::Statistics cache = d->driver->adjacencyCacheStatistics();
+    const qint64 lookups = cache.hits + cache.misses;
+
+    family(out, "arangodb_driver_adjacency_cache_hits", "counter", "Adjacency lookups answered from the cache.");
+    sample(out, "arangodb_driver_adjacency_cache_hits_total", QByteArray(), QByteArray::number(cache.hits));
+    family(out, "arangodb_driver_adjacency_cache_misses", "counter", "Adjacency lookups sent to the server.");
+    sample(out, "arangodb_driver_adjacency_cache_misses_total", QByteArray(), QByteArray::number(cache.misses));
+    family(out, "arangodb_driver_adjacency_cache_evictions", "counter", "Vertices evicted because of the memory limit.");
+    sample(out, "arangodb_driver_adjacency_cache_evictions_total", QByteArray(), QByteArray::number(cache.evictions));
+    family(out, "arangodb_driver_adjacency_cache_hit_ratio", "gauge", "Share of adjacency lookups answered from the cache.");
+    sample(out, "arangodb_driver_adjacency_cache_hit_ratio", QByteArray(),
+           QByteArray::number((lookups == 0) ? 0.0 : double(cache.hits) / lookups, 'g', 6));
+    family(out, "arangodb_driver_adjacency_cache_bytes", "gauge", "Memory used by the adjacency cache.");
+    out += QByteArrayLiteral("# UNIT arangodb_driver_adjacency_cache_bytes bytes\n");
+    sample(out, "arangodb_driver_adjacency_cache_bytes", QByteArray(), QByteArray::number(cache.bytes));
+
+    out += QByteArrayLiteral("# EOF\n");
+    return out;
+}
+
+bool MetricsExporter::listen(const QHostAddress & address, quint16 port)
+{
+    Q_D(MetricsExporter);
+
+    if ( d->server == nullptr ) {
+        d->server = new QTcpServer(this);
+        connect(d->server, &QTcpServer::newConnection,
+                this, &MetricsExporter::_ar_new_connection
+                );
+    }
+
+    d->server->close();
+    return d->server->listen(address, port);
+}
+
+void MetricsExporter::close()
+{
+    Q_D(MetricsExporter);
+
+    if ( d->server != nullptr ) {
+        d->server->close();
+    }
+}
+
+bool MetricsExporter::isListening() const
+{
+    Q_D(const MetricsExporter);
+    return d->server != nullptr && d->server->isListening();
+}
+
+quint16 MetricsExporter::serverPort() const
+{
+    Q_D(const MetricsExporter);
+    return (d->server == nullptr) ? 0 : d->server->serverPort();
+}
+
+void MetricsExporter::_ar_new_connection()
+{
+    Q_D(MetricsExporter);
+
+    while ( QTcpSocket * socket = d->server->nextPendingConnection() ) {
+        connect(socket, &QTcpSocket::readyRead,
+                this, &MetricsExporter::_ar_request_received
+                );
+        connect(socket, &QTcpSocket::disconnected,
+                socket, &QTcpSocket::deleteLater
+                );
+    }
+}
+
+void MetricsExporter::_ar_request_received()
+{
+    QTcpSocket * socket = qobject_cast<QTcpSocket *>(sender());
+    if ( socket == nullptr ) return;
+
+    // Wait until the whole header is there, a
+    // scrape request never has a body
+    const QByteArray buffer = socket->peek(MaxRequestSize);
+    const int headerEnd = buffer.indexOf("\r\n\r\n");
+    if ( headerEnd < 0 ) {
+        if ( socket->bytesAvailable() >= MaxRequestSize ) socket->abort();
+        return;
+    }
+
+    socket->disconnect(this);
+    socket->read(headerEnd + 4);
+
+    const QList<QByteArray> requestLine = buffer.left(buffer.indexOf("\r\n")).split(' ');
+    const QByteArray method = requestLine.value(0);
+    const QByteArray path = requestLine.value(1).split('?').first();
+
+    QByteArray status = QByteArrayLiteral("200 OK");
+    QByteArray contentType = ContentType;
+    QByteArray body;
+
+    if ( method != "GET" && method != "HEAD" ) {
+        status = QByteArrayLiteral("405 Method Not Allowed");
+        contentType = QByteArrayLiteral("text/plain");
+    }
+    else if ( path != "/metrics" ) {
+        status = QByteArrayLiteral("404 Not Found");
+        contentType = QByteArrayLiteral("text/plain");
+    }
+    else {
+        body = render();
+    }
+
+    // HEAD gets the headers of GET, including the
+    // length of the body which is left out
+    QByteArray reply = QByteArrayLiteral("HTTP/1.1 ") + status + "\r\n"
+            + "Content-Type: " + contentType + "\r\n"
+            + "Content-Length: " + QByteArray::number(body.size()) + "\r\n"
+            + "Connection: close\r\n\r\n";
+    if ( method != "HEAD" ) reply += body;
+
+    socket->write(reply);
+    socket->disconnectFromHost();
+}
+
+}
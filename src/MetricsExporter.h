@@ -0,0 +1,155 @@
+/********************************************************************************
+ ** The MIT License (MIT)
+ **
+ ** Copyright (c) 2013 Sascha Ludwig Häusler
+ **
+ ** Permission is hereby granted, free of charge, to any person obtaining a copy of
+ ** this software and associated documentation files (the "Software"), to deal in
+ ** the Software without restriction, including without limitation the rights to
+ ** use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ ** the Software, and to permit persons to whom the Software is furnished to do so,
+ ** subject to the following conditions:
+ **
+ ** The above copyright notice and this permission notice shall be included in all
+ ** copies or substantial portions of the Software.
+ **
+ ** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ ** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ ** FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ ** COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ ** IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ ** CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *********************************************************************************/
+
+#ifndef METRICSEXPORTER_H
+#define METRICSEXPORTER_H
+
+#include "arangodb-driver_global.h"
+
+#include <QtCore/QByteArray>
+#include <QtCore/QObject>
+#include <QtNetwork/QHostAddress>
+
+namespace arangodb
+{
+
+class Arangodbdriver;
+class MetricsExporterPrivate;
+
+/**
+ * @brief Renders the statistics of a driver in the OpenMetrics
+ * text format, which is scraped by Prometheus. Covered are
+ * requests, errors, bytes and latency histograms per operation,
+ * the number of requests in flight, open cursors and the
+ * adjacency cache.
+ *
+ * The exporter can serve the metrics itself on /metrics:
+ *
+ * @code
+ * MetricsExporter exporter(&driver);
+ * exporter.listen(QHostAddress::Any, 9464);
+ * @endcode
+ *
+ * @since 0.6
+ */
+class ARANGODBDRIVERSHARED_EXPORT MetricsExporter : public QObject
+{
+        Q_OBJECT
+    public:
+        /**
+         * @brief MetricsExporter
+         *
+         * @param driver
+         * @param parent
+         *
+         * @since 0.6
+         */
+        explicit MetricsExporter(Arangodbdriver * driver, QObject * parent = nullptr);
+
+        /**
+         * @brief ~MetricsExporter
+         *
+         * @since 0.6
+         */
+        virtual ~MetricsExporter();
+
+        /**
+         * @brief Returns the current metrics of the driver
+         * in the OpenMetrics text format
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        QByteArray render() const;
+
+        /**
+         * @brief Starts the embedded HTTP endpoint which answers
+         * GET /metrics with render()
+         *
+         * @param address
+         * @param port      0 chooses a free port (see serverPort)
+         *
+         * @return false if the port couldn't be opened
+         *
+         * @since 0.6
+         */
+        bool listen(const QHostAddress & address = QHostAddress::LocalHost, quint16 port = 0);
+
+        /**
+         * @brief Stops the embedded HTTP endpoint
+         *
+         * @since 0.6
+         */
+        void close();
+
+        /**
+         * @brief isListening
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        bool isListening() const;
+
+        /**
+         * @brief Returns the port of the embedded HTTP endpoint
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        quint16 serverPort() const;
+
+        /**
+         * @brief The media type of render()
+         *
+         * @since 0.6
+         */
+        static const QByteArray ContentType;
+
+    protected:
+        MetricsExporterPrivate *d_ptr;
+
+    protected Q_SLOTS:
+        /**
+         * @brief _ar_new_connection
+         *
+         * @since 0.6
+         */
+        void _ar_new_connection();
+
+        /**
+         * @brief _ar_request_received
+         *
+         * @since 0.6
+         */
+        void _ar_request_received();
+
+    private:
+        Q_DECLARE_PRIVATE(MetricsExporter)
+};
+
+}
+
+#endif // METRICSEXPORTER_H
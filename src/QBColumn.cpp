@@ -0,0 +1,228 @@
+/********************************************************************************
+ ** The MIT License (MIT)
+ **
+ ** Copyright (c) 2013 Sascha Ludwig Häusler
+ **
+ ** Permission is hereby granted, free of charge, to any person obtaining a copy of
+ ** this software and associated documentation files (the "Software"), to deal in
+ ** the Software without restriction, including without limitation the rights to
+ ** use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ ** the Software, and to permit persons to whom the Software is furnished to do so,
+ ** subject to the following conditions:
+ **
+ ** The above copyright notice and this permission notice shall be included in all
+ ** copies or substantial portions of the Software.
+ **
+ ** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ ** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ ** FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ ** COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ ** IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ ** CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *********************************************************************************/
+
+#include "QBColumn.h"
+
+#include <QtCore/qnumeric.h>
+
+namespace arangodb
+{
+
+QBColumn::QBColumn(const QString & name) :
+    m_name(name),
+    m_type(Type::NullType),
+    m_size(0)
+{
+}
+
+QString QBColumn::name() const
+{
+    return m_name;
+}
+
+QBColumn::Type QBColumn::type() const
+{
+    return m_type;
+}
+
+int QBColumn::validCount() const
+{
+    int count = 0;
+    for ( quint32 word : m_validity ) {
+        while (word) {
+            word &= word - 1;
+            ++count;
+        }
+    }
+
+    return count;
+}
+
+QString QBColumn::stringAt(int row) const
+{
+    if ( m_type != Type::StringType ) {
+        return QString();
+    }
+
+    const int start = m_stringOffsets.at(row);
+    return m_stringData.mid(start, m_stringOffsets.at(row + 1) - start);
+}
+
+void QBColumn::append(const QJsonValue & value)
+{
+    // The first real value decides the type of the column,
+    // all rows before it get a default value
+    if ( m_type == Type::NullType ) {
+        switch (value.type())
+        {
+            case QJsonValue::Bool:
+                m_type = Type::BoolType;
+                m_bools.fill(0, m_size);
+                break;
+
+            case QJsonValue::Double:
+                m_type = Type::Int64Type;
+                m_ints.fill(0, m_size);
+                break;
+
+            case QJsonValue::String:
+                m_type = Type::StringType;
+                m_stringOffsets.fill(0, m_size + 1);
+                break;
+
+            default:
+                appendNull();
+                return;
+        }
+    }
+
+    switch (m_type)
+    {
+        case Type::BoolType:
+            if ( value.isBool() ) {
+                m_bools.append(value.toBool() ? 1 : 0);
+                appendSlot(true);
+                return;
+            }
+            m_bools.append(0);
+            break;
+
+        case Type::Int64Type:
+            if ( value.isDouble() ) {
+                const double number = value.toDouble();
+                // Converting a value outside of the qint64 range is undefined,
+                // so the range is checked before the cast
+                if ( qIsFinite(number)
+                     && number >= -9223372036854775808.0 && number < 9223372036854775808.0 ) {
+                    const qint64 integer = qint64(number);
+                    // Only integers which can be exactly represented as double
+                    if ( double(integer) == number && qAbs(number) < 9007199254740992.0 ) {
+                        m_ints.append(integer);
+                        appendSlot(true);
+                        return;
+                    }
+                }
+                convertToDouble();
+                m_doubles.append(number);
+                appendSlot(true);
+                return;
+            }
+            m_ints.append(0);
+            break;
+
+        case Type::DoubleType:
+            if ( value.isDouble() ) {
+                m_doubles.append(value.toDouble());
+                appendSlot(true);
+                return;
+            }
+            m_doubles.append(0.0);
+            break;
+
+        case Type::StringType:
+            if ( value.isString() ) {
+                m_stringData += value.toString();
+                m_stringOffsets.append(m_stringData.size());
+                appendSlot(true);
+                return;
+            }
+            m_stringOffsets.append(m_stringData.size());
+            break;
+
+        default:
+            break;
+    }
+
+    appendSlot(false);
+}
+
+void QBColumn::appendNull(int count)
+{
+    for (int i = 0; i < count; ++i) {
+        switch (m_type)
+        {
+            case Type::BoolType:
+                m_bools.append(0);
+                break;
+
+            case Type::Int64Type:
+                m_ints.append(0);
+                break;
+
+            case Type::DoubleType:
+                m_doubles.append(0.0);
+                break;
+
+            case Type::StringType:
+                m_stringOffsets.append(m_stringData.size());
+                break;
+
+            default:
+                break;
+        }
+
+        appendSlot(false);
+    }
+}
+
+void QBColumn::clear()
+{
+    m_size = 0;
+    m_ints.clear();
+    m_doubles.clear();
+    m_bools.clear();
+    m_stringData.clear();
+    m_stringOffsets.clear();
+    m_validity.clear();
+
+    if ( m_type == Type::StringType ) {
+        m_stringOffsets.append(0);
+    }
+}
+
+void QBColumn::appendSlot(bool valid)
+{
+    const int word = m_size >> 5;
+    if ( word == m_validity.size() ) {
+        m_validity.append(0);
+    }
+
+    if ( valid ) {
+        m_validity[word] |= (1u << (m_size & 31));
+    }
+
+    ++m_size;
+}
+
+void QBColumn::convertToDouble()
+{
+    m_doubles.reserve(m_ints.size() + 1);
+    for ( qint64 integer : m_ints ) {
+        m_doubles.append(double(integer));
+    }
+
+    m_ints.clear();
+    m_type = Type::DoubleType;
+}
+
+}
@@ -0,0 +1,283 @@
+/********************************************************************************
+ ** The MIT License (MIT)
+ **
+ ** Copyright (c) 2013 Sascha Ludwig Häusler
+ **
+ ** Permission is hereby granted, free of charge, to any person obtaining a copy of
+ ** this software and associated documentation files (the "Software"), to deal in
+ ** the Software without restriction, including without limitation the rights to
+ ** use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ ** the Software, and to permit persons to whom the Software is furnished to do so,
+ ** subject to the following conditions:
+ **
+ ** The above copyright notice and this permission notice shall be included in all
+ ** copies or substantial portions of the Software.
+ **
+ ** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ ** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ ** FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ ** COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ ** IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ ** CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *********************************************************************************/
+
+#ifndef QBCOLUMN_H
+#define QBCOLUMN_H
+
+#include "arangodb-driver_global.h"
+
+#include <QtCore/QJsonValue>
+#include <QtCore/QString>
+#include <QtCore/QVector>
+
+namespace arangodb
+{
+
+/**
+ * @brief One attribute of a columnar cursor result stored as
+ * contiguous typed values plus a validity bitmap. The first
+ * non null value decides the type of the column, numbers stay
+ * integers until the first fractional value shows up. Rows
+ * whose value is missing, null or of another type are invalid
+ * and hold 0 (or an empty string) in the value array.
+ *
+ * @since 0.6
+ */
+class ARANGODBDRIVERSHARED_EXPORT QBColumn
+{
+    public:
+        /**
+         * @brief The Type enum
+         *
+         * @since 0.6
+         */
+        enum class Type : quint8 {
+            NullType    = 0,
+            BoolType    = 1,
+            Int64Type   = 2,
+            DoubleType  = 3,
+            StringType  = 4
+        };
+
+        /**
+         * @brief QBColumn
+         *
+         * @param name
+         *
+         * @since 0.6
+         */
+        explicit QBColumn(const QString & name = QString());
+
+        /**
+         * @brief name
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        QString name() const;
+
+        /**
+         * @brief type
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        Type type() const;
+
+        /**
+         * @brief Number of rows in this column
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        inline int size() const {
+            return m_size;
+        }
+
+        /**
+         * @brief isValid
+         *
+         * @param row
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        inline bool isValid(int row) const {
+            return m_validity.at(row >> 5) & (1u << (row & 31));
+        }
+
+        /**
+         * @brief Number of valid rows in this column
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        int validCount() const;
+
+        /**
+         * @brief int64At
+         *
+         * @param row
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        inline qint64 int64At(int row) const {
+            return (m_type == Type::DoubleType) ? qint64(m_doubles.at(row)) : m_ints.at(row);
+        }
+
+        /**
+         * @brief doubleAt
+         *
+         * @param row
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        inline double doubleAt(int row) const {
+            return (m_type == Type::Int64Type) ? double(m_ints.at(row)) : m_doubles.at(row);
+        }
+
+        /**
+         * @brief boolAt
+         *
+         * @param row
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        inline bool boolAt(int row) const {
+            return m_bools.at(row) != 0;
+        }
+
+        /**
+         * @brief stringAt
+         *
+         * @param row
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        QString stringAt(int row) const;
+
+        /**
+         * @brief Values of an integer column, one per row
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        inline const QVector<qint64> & int64Values() const {
+            return m_ints;
+        }
+
+        /**
+         * @brief Values of a double column, one per row
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        inline const QVector<double> & doubleValues() const {
+            return m_doubles;
+        }
+
+        /**
+         * @brief Values of a bool column, one byte per row
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        inline const QVector<quint8> & boolValues() const {
+            return m_bools;
+        }
+
+        /**
+         * @brief Offsets of a string column into stringData(),
+         * row i spans from offset i to offset i+1
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        inline const QVector<int> & stringOffsets() const {
+            return m_stringOffsets;
+        }
+
+        /**
+         * @brief All strings of a string column concatenated
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        inline const QString & stringData() const {
+            return m_stringData;
+        }
+
+        /**
+         * @brief Validity bitmap, bit (row % 32) of word (row / 32)
+         * is set for every valid row
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        inline const QVector<quint32> & validity() const {
+            return m_validity;
+        }
+
+        /**
+         * @brief Appends the value as a new row
+         *
+         * @param value
+         *
+         * @since 0.6
+         */
+        void append(const QJsonValue & value);
+
+        /**
+         * @brief Appends invalid rows
+         *
+         * @param count
+         *
+         * @since 0.6
+         */
+        void appendNull(int count = 1);
+
+        /**
+         * @brief Removes all rows but keeps the type
+         *
+         * @since 0.6
+         */
+        void clear();
+
+    private:
+        void appendSlot(bool valid);
+        void convertToDouble();
+
+        QString m_name;
+        Type m_type;
+        int m_size;
+
+        QVector<qint64> m_ints;
+        QVector<double> m_doubles;
+        QVector<quint8> m_bools;
+        QVector<int> m_stringOffsets;
+        QString m_stringData;
+        QVector<quint32> m_validity;
+};
+
+}
+
+#endif // QBCOLUMN_H
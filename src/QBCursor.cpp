@@ -23,12 +23,17 @@
 
 #include "QBCursor.h"
 #include "Arangodbdriver.h"
+#include "private/Document_p.h"
+#include "private/JsonDecoder_p.h"
 
 #include <QtCore/QCoreApplication>
 #include <QtCore/QDebug>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QHash>
 #include <QtCore/QJsonArray>
 #include <QtCore/QJsonDocument>
 #include <QtCore/QJsonObject>
+#include <QtCore/QPointer>
 #include <QtNetwork/QNetworkReply>
 
 namespace arangodb
@@ -38,18 +43,137 @@ class QBCursorPrivate
 {
     public:
         bool hasMore;
+        bool isBatchRecycling = false;
         QString id;
         QList<Document *> docs;
+        QList<Document *> spareDocs;
+
+        QIODevice * device = Q_NULLPTR;
+
+        bool isDisposed = false;
+        QPointer<internal::JsonDecoder> decoder;
+
+        bool isColumnar = false;
+        QVector<QBColumn> columns;
+        QHash<QString, int> columnIndexes;
+        int rowCount = 0;
+
+        qint64 totalCount = -1;
+        bool isCached = false;
+
+        QElapsedTimer requestTimer;
+        QElapsedTimer decodeTimer;
+        QBCursor::BatchStatistics batch;
+        QList<QBCursor::BatchStatistics> batches;
+
+        bool hasStatistics = false;
+        QBCursor::Statistics statistics;
+        QJsonObject profile;
 
         QString errorMessage;
         quint32 errorCode = 0;
         quint32 errorNumber = 0;
 
+        /**
+         * @brief bytes of the loaded batches counted in MemoryAccounting
+         */
+        qint64 accountedBytes = 0;
+
+        inline void account(qint64 bytes) {
+            internal::MemoryAccounting::cursorBytes.fetchAndAddRelaxed(bytes);
+            accountedBytes += bytes;
+        }
+
         inline void resetError() {
             errorMessage.clear();
             errorCode = 0;
             errorNumber = 0;
         }
+
+        /**
+         * @brief Reads the statistics and the profile of the query,
+         * which the server sends with one of the batches
+         *
+         * @param extra
+         *
+         * @since 0.6
+         */
+        inline void setExtra(const QJsonObject & extra) {
+            if ( extra.contains(QStringLiteral("stats")) ) {
+                const QJsonObject stats = extra.value(QStringLiteral("stats")).toObject();
+                statistics.scannedFull      = qint64(stats.value(QStringLiteral("scannedFull")).toDouble());
+                statistics.scannedIndex     = qint64(stats.value(QStringLiteral("scannedIndex")).toDouble());
+                statistics.filtered         = qint64(stats.value(QStringLiteral("filtered")).toDouble());
+                statistics.fullCount        = qint64(stats.value(QStringLiteral("fullCount")).toDouble(-1));
+                statistics.executionTime    = stats.value(QStringLiteral("executionTime")).toDouble();
+                statistics.peakMemoryUsage  = qint64(stats.value(QStringLiteral("peakMemoryUsage")).toDouble());
+                hasStatistics = true;
+
+                batch.serverExecutionTime = statistics.executionTime;
+            }
+
+            if ( extra.contains(QStringLiteral("profile")) ) {
+                profile = extra.value(QStringLiteral("profile")).toObject();
+            }
+        }
+
+        /**
+         * @brief Records the statistics of the batch which
+         * has just been decoded
+         *
+         * @param rows
+         *
+         * @since 0.6
+         */
+        inline void finishBatch(int rows) {
+            batch.rows = rows;
+            batch.decodeTime = decodeTimer.nsecsElapsed() / 1000;
+            batches.append(batch);
+        }
+
+        /**
+         * @brief Appends every row to the columns, attributes
+         * which show up for the first time get a new column
+         * which is invalid for all previous rows
+         *
+         * @param rows
+         *
+         * @since 0.6
+         */
+        inline void appendColumnarRows(const QJsonArray & rows) {
+            const int total = rows.size();
+            for (int i = 0; i < total; ++i) {
+                const QJsonObject row = rows.at(i).toObject();
+                int matched = 0;
+
+                const int totalColumns = columns.size();
+                for (int c = 0; c < totalColumns; ++c) {
+                    QBColumn & column = columns[c];
+                    QJsonObject::const_iterator it = row.constFind(column.name());
+                    if ( it == row.constEnd() ) {
+                        column.appendNull();
+                    }
+                    else {
+                        column.append(it.value());
+                        ++matched;
+                    }
+                }
+
+                if ( matched < row.size() ) {
+                    for ( auto it = row.constBegin(); it != row.constEnd(); ++it ) {
+                        if ( columnIndexes.contains(it.key()) ) continue;
+
+                        QBColumn column(it.key());
+                        column.appendNull(rowCount);
+                        column.append(it.value());
+                        columnIndexes.insert(it.key(), columns.size());
+                        columns.append(column);
+                    }
+                }
+
+                ++rowCount;
+            }
+        }
 };
 
 QBCursor::QBCursor(QObject *parent) :
@@ -58,6 +182,21 @@ QBCursor::QBCursor(QObject *parent) :
 {
     Q_D(QBCursor);
     d->hasMore = false;
+
+    // The first request is sent right after the cursor is created
+    d->requestTimer.start();
+}
+
+QBCursor::~QBCursor()
+{
+    Arangodbdriver * driver = qobject_cast<Arangodbdriver *>(parent());
+    if (driver) {
+        driver->abandonCursor(this, d_ptr->decoder);
+    }
+
+    d_ptr->account(-d_ptr->accountedBytes);
+
+    delete d_ptr;
 }
 
 bool QBCursor::hasMore() const
@@ -105,11 +244,128 @@ QList<Document *> QBCursor::data()
 int QBCursor::count() const
 {
     Q_D(const QBCursor);
-    return d->docs.count();
+    return (d->isColumnar || d->device) ? d->rowCount : d->docs.count();
+}
+
+void QBCursor::setBatchRecycling(bool recycle)
+{
+    Q_D(QBCursor);
+    d->isBatchRecycling = recycle;
+}
+
+bool QBCursor::isBatchRecycling() const
+{
+    Q_D(const QBCursor);
+    return d->isBatchRecycling;
+}
+
+void QBCursor::setColumnar(bool columnar)
+{
+    Q_D(QBCursor);
+    d->isColumnar = columnar;
+}
+
+bool QBCursor::isColumnar() const
+{
+    Q_D(const QBCursor);
+    return d->isColumnar;
+}
+
+QVector<QBColumn> QBCursor::columns() const
+{
+    Q_D(const QBCursor);
+    return d->columns;
+}
+
+QBColumn QBCursor::column(const QString & name) const
+{
+    Q_D(const QBCursor);
+    const int index = d->columnIndexes.value(name, -1);
+    return (index < 0) ? QBColumn(name) : d->columns.at(index);
+}
+
+qint64 QBCursor::totalCount() const
+{
+    Q_D(const QBCursor);
+    return d->totalCount;
+}
+
+bool QBCursor::isCached() const
+{
+    Q_D(const QBCursor);
+    return d->isCached;
+}
+
+QList<QBCursor::BatchStatistics> QBCursor::batchStatistics() const
+{
+    Q_D(const QBCursor);
+    return d->batches;
+}
+
+bool QBCursor::hasStatistics() const
+{
+    Q_D(const QBCursor);
+    return d->hasStatistics;
+}
+
+QBCursor::Statistics QBCursor::statistics() const
+{
+    Q_D(const QBCursor);
+    return d->statistics;
+}
+
+QJsonObject QBCursor::profile() const
+{
+    Q_D(const QBCursor);
+    return d->profile;
+}
+
+void QBCursor::setOutputDevice(QIODevice * device)
+{
+    Q_D(QBCursor);
+    d->device = device;
+}
+
+QIODevice * QBCursor::outputDevice() const
+{
+    Q_D(const QBCursor);
+    return d->device;
+}
+
+void QBCursor::clearData()
+{
+    Q_D(QBCursor);
+
+    const int totalColumns = d->columns.size();
+    for (int i = 0; i < totalColumns; ++i) {
+        d->columns[i].clear();
+    }
+    d->rowCount = 0;
+    d->account(-d->accountedBytes);
+
+    if ( d->isBatchRecycling ) {
+        for ( Document * doc : d->docs ) {
+            // Drops the reference to the storage of the old batch
+            doc->d_ptr->releaseAccounting();
+            doc->d_ptr->data = QJsonObject();
+            // Receivers connected to the old row must not
+            // get the signals of the row it is reused for
+            doc->disconnect();
+        }
+        d->spareDocs.append(d->docs);
+    }
+    else {
+        qDeleteAll(d->docs);
+    }
+
+    d->docs.clear();
 }
 
 void QBCursor::getMoreData()
 {
+    Q_D(QBCursor);
+    d->requestTimer.start();
+
     Arangodbdriver * driver = qobject_cast<Arangodbdriver *>(parent());
     if (driver) {
         driver->loadMoreResults(this);
@@ -136,6 +392,19 @@ void QBCursor::waitForResult()
     QObject::disconnect(conn2);
 }
 
+void QBCursor::dispose()
+{
+    Q_D(QBCursor);
+
+    Arangodbdriver * driver = qobject_cast<Arangodbdriver *>(parent());
+    if (driver) {
+        driver->disposeCursor(this);
+    }
+
+    d->isDisposed = true;
+    d->hasMore = false;
+}
+
 void QBCursor::_ar_cursor_result_loaded()
 {
     Q_D(QBCursor);
@@ -147,8 +416,29 @@ void QBCursor::_ar_cursor_result_loaded()
 
     QByteArray data = reply->readAll();
 
-    QJsonDocument doc = QJsonDocument::fromJson(data);
-    QJsonObject obj = doc.object();
+    d->batch = BatchStatistics();
+    d->batch.requestTime = d->requestTimer.elapsed();
+    d->batch.bytes = data.size();
+    d->decodeTimer.start();
+
+    // Parsing a big batch would stall every other
+    // reply which is handled by the event loop
+    Arangodbdriver * driver = qobject_cast<Arangodbdriver *>(parent());
+    const int threshold = driver ? driver->backgroundDecodeThreshold() : -1;
+    if ( threshold >= 0 && data.size() >= threshold ) {
+        d->decoder = new internal::JsonDecoder(this, [this](const QJsonDocument & document) {
+            processBatch(document.object());
+        });
+        d->decoder->start(driver->decodeThreadPool(), data);
+        return;
+    }
+
+    processBatch(QJsonDocument::fromJson(data).object());
+}
+
+void QBCursor::processBatch(const QJsonObject & obj)
+{
+    Q_D(QBCursor);
 
     d->resetError();
 
@@ -164,13 +454,92 @@ void QBCursor::_ar_cursor_result_loaded()
     d->hasMore = obj.value(QStringLiteral("hasMore")).toBool();
     d->id      = obj.value(QStringLiteral("id")).toString();
 
-    QJsonArray dataArr = obj.value(QStringLiteral("result")).toArray();
+    // Disposed before the first batch arrived, the id is only
+    // kept for the driver to release the cursor on the server
+    if ( d->isDisposed ) {
+        if ( !d->hasMore ) {
+            d->id.clear();
+        }
+        d->hasMore = false;
+    }
+
+    // Only sent with the first batch
+    if ( obj.contains(QStringLiteral("count")) ) {
+        d->totalCount = qint64(obj.value(QStringLiteral("count")).toDouble());
+    }
+    if ( obj.contains(QStringLiteral("cached")) ) {
+        d->isCached = obj.value(QStringLiteral("cached")).toBool();
+    }
+
+    if ( obj.contains(QStringLiteral("extra")) ) {
+        d->setExtra(obj.value(QStringLiteral("extra")).toObject());
+    }
+
+    // The rows of the batch share the storage of the parsed reply
+    // until they are modified, so the batch is one allocation
+    // The edges API returns its documents under another name
+    QJsonArray dataArr = obj.contains(QStringLiteral("result")) ? obj.value(QStringLiteral("result")).toArray()
+                                                                : obj.value(QStringLiteral("edges")).toArray();
     const int total = dataArr.size();
+
+    if ( d->device ) {
+        for (int i = 0; i < total; ++i) {
+            QByteArray line = QJsonDocument(dataArr.at(i).toObject()).toJson(QJsonDocument::Compact);
+            line.append('\n');
+
+            if ( d->device->write(line) < 0 ) {
+                // There is no status code for client side errors
+                d->errorMessage = d->device->errorString();
+                d->errorCode    = 1;
+                dispose();
+
+                emit error();
+                return;
+            }
+        }
+
+        d->rowCount += total;
+        d->finishBatch(total);
+
+        if ( d->hasMore ) {
+            getMoreData();
+        }
+        else {
+            emit ready();
+        }
+        return;
+    }
+
+    if ( d->isBatchRecycling ) {
+        clearData();
+    }
+
+    // The size of the reply stands for the batch, counting
+    // it once is much cheaper than estimating every row
+    d->account(d->batch.bytes);
+
+    if ( d->isColumnar ) {
+        d->appendColumnarRows(dataArr);
+        d->finishBatch(total);
+        emit ready();
+        return;
+    }
+
+    d->docs.reserve(d->docs.size() + total);
     for (int i = 0; i < total; ++i) {
-        Document * doc = new Document(dataArr.at(i).toObject());
+        Document * doc = Q_NULLPTR;
+        if ( d->spareDocs.isEmpty() ) {
+            doc = new Document(d->isBatchRecycling ? this : Q_NULLPTR);
+        }
+        else {
+            doc = d->spareDocs.takeLast();
+        }
+
+        doc->d_ptr->setCursorResult(dataArr.at(i).toObject());
         d->docs.append(doc);
     }
 
+    d->finishBatch(total);
     emit ready();
 }
 
@@ -26,7 +26,10 @@
 
 #include "arangodb-driver_global.h"
 #include "Document.h"
+#include "QBColumn.h"
 
+#include <QtCore/QIODevice>
+#include <QtCore/QJsonObject>
 #include <QtCore/QList>
 
 namespace arangodb
@@ -44,6 +47,104 @@ class ARANGODBDRIVERSHARED_EXPORT QBCursor : public QObject
 {
         Q_OBJECT
     public:
+        /**
+         * @brief The statistics of the query execution
+         * as sent by the server
+         *
+         * @since 0.6
+         */
+        struct Statistics {
+                /**
+                 * @brief documents read without an index
+                 *
+                 * @since 0.6
+                 */
+                qint64 scannedFull = 0;
+
+                /**
+                 * @brief documents read through an index
+                 *
+                 * @since 0.6
+                 */
+                qint64 scannedIndex = 0;
+
+                /**
+                 * @brief documents removed by a filter
+                 *
+                 * @since 0.6
+                 */
+                qint64 filtered = 0;
+
+                /**
+                 * @brief documents matching without the limit,
+                 * -1 if not requested (see QBSelect::setFullCount)
+                 *
+                 * @since 0.6
+                 */
+                qint64 fullCount = -1;
+
+                /**
+                 * @brief execution time on the server in seconds
+                 *
+                 * @since 0.6
+                 */
+                double executionTime = 0.0;
+
+                /**
+                 * @brief highest memory usage of the query in bytes
+                 *
+                 * @since 0.6
+                 */
+                qint64 peakMemoryUsage = 0;
+        };
+
+        /**
+         * @brief Timing and size of one loaded batch, to tell
+         * the time spent on the server, in transfer and in
+         * decoding apart
+         *
+         * @since 0.6
+         */
+        struct BatchStatistics {
+                /**
+                 * @brief number of rows in the batch
+                 *
+                 * @since 0.6
+                 */
+                int rows = 0;
+
+                /**
+                 * @brief size of the reply body in bytes
+                 *
+                 * @since 0.6
+                 */
+                qint64 bytes = 0;
+
+                /**
+                 * @brief milliseconds from sending the request
+                 * until the whole reply was received
+                 *
+                 * @since 0.6
+                 */
+                qint64 requestTime = 0;
+
+                /**
+                 * @brief microseconds spent parsing the reply and
+                 * creating the documents, columns or output lines
+                 *
+                 * @since 0.6
+                 */
+                qint64 decodeTime = 0;
+
+                /**
+                 * @brief execution time on the server in seconds,
+                 * only set for the batch which carried the statistics
+                 *
+                 * @since 0.6
+                 */
+                double serverExecutionTime = 0.0;
+        };
+
         /**
          * @brief QBCursor
          *
@@ -54,6 +155,13 @@ class ARANGODBDRIVERSHARED_EXPORT QBCursor : public QObject
          */
         QBCursor(QObject *parent = 0);
 
+        /**
+         * @brief ~QBCursor
+         *
+         * @since 0.6
+         */
+        virtual ~QBCursor();
+
         /**
          * @brief hasMore
          *
@@ -134,6 +242,167 @@ class ARANGODBDRIVERSHARED_EXPORT QBCursor : public QObject
          */
         int count() const;
 
+        /**
+         * @brief If batch recycling is enabled, every loaded batch
+         * replaces the previous one instead of being appended to it.
+         * The Document objects of the previous batch are owned by the
+         * cursor and reused for the rows of the next batch, so pointers
+         * returned by data() are only valid until the next batch
+         * has been loaded. A reused document is reset to a fresh
+         * cursor row and loses all connections to its signals.
+         *
+         * @param recycle
+         *
+         * @since 0.6
+         */
+        void setBatchRecycling(bool recycle);
+
+        /**
+         * @brief isBatchRecycling
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        bool isBatchRecycling() const;
+
+        /**
+         * @brief In columnar mode the rows are not turned into
+         * Document objects but decoded into one typed column per
+         * attribute, which is meant for reading a few fields of
+         * many homogeneous rows (see QBSelect::setResult).
+         * data() stays empty, count() returns the number of rows.
+         *
+         * @param columnar
+         *
+         * @since 0.6
+         */
+        void setColumnar(bool columnar);
+
+        /**
+         * @brief isColumnar
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        bool isColumnar() const;
+
+        /**
+         * @brief Returns the columns decoded so far in the order
+         * their attributes first appeared in the result
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        QVector<QBColumn> columns() const;
+
+        /**
+         * @brief Returns the column for the attribute or an empty
+         * column if the attribute did not appear in the result
+         *
+         * @param name
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        QBColumn column(const QString & name) const;
+
+        /**
+         * @brief Returns the number of all results on the server,
+         * or -1 if the select was not counting (see QBSelect::setCounting).
+         * count() only returns the rows loaded so far.
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        qint64 totalCount() const;
+
+        /**
+         * @brief Returns if the result came from the query
+         * result cache of the server
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        bool isCached() const;
+
+        /**
+         * @brief Returns the statistics of every batch loaded so
+         * far. The request time of a batch is measured from the
+         * creation of the cursor or the getMoreData() call.
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        QList<BatchStatistics> batchStatistics() const;
+
+        /**
+         * @brief Returns if the server has sent the statistics
+         * of the query yet
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        bool hasStatistics() const;
+
+        /**
+         * @brief statistics
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        Statistics statistics() const;
+
+        /**
+         * @brief Returns the time in seconds of every execution
+         * phase if the select was profiled (see QBSelect::setProfiling)
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        QJsonObject profile() const;
+
+        /**
+         * @brief If a device is set, every row is written to it as
+         * one line of compact JSON instead of being turned into a
+         * Document object. The cursor loads all batches on its own
+         * and emits ready once the last one has been written,
+         * count() returns the number of written rows.
+         *
+         * @param device
+         *
+         * @since 0.6
+         */
+        void setOutputDevice(QIODevice * device);
+
+        /**
+         * @brief outputDevice
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        QIODevice * outputDevice() const;
+
+        /**
+         * @brief Releases all loaded documents in one step. With batch
+         * recycling enabled the Document objects are kept for the next
+         * batch, otherwise they are deleted. Columns keep their
+         * types but lose all rows.
+         *
+         * @since 0.6
+         */
+        void clearData();
+
         /**
          * @brief getMoreData
          *
@@ -150,6 +419,16 @@ class ARANGODBDRIVERSHARED_EXPORT QBCursor : public QObject
          */
         void waitForResult();
 
+        /**
+         * @brief Releases the cursor on the server if it still
+         * has results there. Already loaded data stays available
+         * but no more data can be loaded afterwards. This is done
+         * automatically when the cursor is destroyed.
+         *
+         * @since 0.6
+         */
+        void dispose();
+
     public Q_SLOTS:
         /**
          * @brief _ar_cursor_result_loaded
@@ -181,6 +460,16 @@ class ARANGODBDRIVERSHARED_EXPORT QBCursor : public QObject
 
     private:
         Q_DECLARE_PRIVATE(QBCursor)
+
+        /**
+         * @brief Takes over the parsed reply of a batch
+         * and emits ready or error
+         *
+         * @param obj
+         *
+         * @since 0.6
+         */
+        void processBatch(const QJsonObject & obj);
 };
 
 }
@@ -0,0 +1,220 @@
+/********************************************************************************
+ ** The MIT License (MIT)
+ **
+ ** Copyright (c) 2013 Sascha Ludwig Häusler
+ **
+ ** Permission is hereby granted, free of charge, to any person obtaining a copy of
+ ** this software and associated documentation files (the "Software"), to deal in
+ ** the Software without restriction, including without limitation the rights to
+ ** use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ ** the Software, and to permit persons to whom the Software is furnished to do so,
+ ** subject to the following conditions:
+ **
+ ** The above copyright notice and this permission notice shall be included in all
+ ** copies or substantial portions of the Software.
+ **
+ ** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ ** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ ** FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ ** COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ ** IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ ** CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *********************************************************************************/
+
+#include "QBExplain.h"
+
+#include <QtCore/QEventLoop>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QVariant>
+#include <QtNetwork/QNetworkReply>
+
+namespace arangodb
+{
+
+class QBExplainPrivate
+{
+    public:
+        QJsonObject plan;
+        QStringList warnings;
+
+        bool isFinished = false;
+
+        QString errorMessage;
+        quint32 errorCode = 0;
+        quint32 errorNumber = 0;
+
+        inline QJsonArray nodes() const {
+            return plan.value(QStringLiteral("nodes")).toArray();
+        }
+
+        inline bool containsNode(const QString & type) const {
+            for ( const QJsonValue & node : nodes() ) {
+                if ( node.toObject().value(QStringLiteral("type")).toString() == type ) return true;
+            }
+
+            return false;
+        }
+};
+
+QBExplain::QBExplain(QObject * parent) :
+    QObject(parent),
+    d_ptr(new QBExplainPrivate)
+{
+}
+
+QBExplain::~QBExplain()
+{
+    delete d_ptr;
+}
+
+bool QBExplain::isFinished() const
+{
+    Q_D(const QBExplain);
+    return d->isFinished;
+}
+
+QJsonObject QBExplain::plan() const
+{
+    Q_D(const QBExplain);
+    return d->plan;
+}
+
+QStringList QBExplain::nodeTypes() const
+{
+    Q_D(const QBExplain);
+
+    QStringList types;
+    for ( const QJsonValue & node : d->nodes() ) {
+        types.append(node.toObject().value(QStringLiteral("type")).toString());
+    }
+
+    return types;
+}
+
+double QBExplain::estimatedCost() const
+{
+    Q_D(const QBExplain);
+    return d->plan.value(QStringLiteral("estimatedCost")).toDouble();
+}
+
+qint64 QBExplain::estimatedNrItems() const
+{
+    Q_D(const QBExplain);
+    return qint64(d->plan.value(QStringLiteral("estimatedNrItems")).toDouble());
+}
+
+bool QBExplain::usesIndex() const
+{
+    Q_D(const QBExplain);
+    // Older servers call the node IndexRangeNode
+    return d->containsNode(QStringLiteral("IndexNode")) || d->containsNode(QStringLiteral("IndexRangeNode"));
+}
+
+bool QBExplain::isFullScan() const
+{
+    Q_D(const QBExplain);
+    return d->containsNode(QStringLiteral("EnumerateCollectionNode"));
+}
+
+QStringList QBExplain::indexes() const
+{
+    Q_D(const QBExplain);
+
+    QStringList result;
+    for ( const QJsonValue & value : d->nodes() ) {
+        const QJsonObject node = value.toObject();
+
+        QJsonArray nodeIndexes = node.value(QStringLiteral("indexes")).toArray();
+        if ( node.contains(QStringLiteral("index")) ) {
+            nodeIndexes.append(node.value(QStringLiteral("index")));
+        }
+
+        for ( const QJsonValue & indexValue : nodeIndexes ) {
+            const QJsonObject index = indexValue.toObject();
+
+            QStringList fields;
+            for ( const QJsonValue & field : index.value(QStringLiteral("fields")).toArray() ) {
+                fields.append(field.toString());
+            }
+
+            result.append(QStringLiteral("%1(%2)").arg(index.value(QStringLiteral("type")).toString(),
+                                                       fields.join(QChar(','))));
+        }
+    }
+
+    return result;
+}
+
+QStringList QBExplain::warnings() const
+{
+    Q_D(const QBExplain);
+    return d->warnings;
+}
+
+QString QBExplain::errorMessage() const
+{
+    Q_D(const QBExplain);
+    return d->errorMessage;
+}
+
+quint32 QBExplain::errorCode() const
+{
+    Q_D(const QBExplain);
+    return d->errorCode;
+}
+
+quint32 QBExplain::errorNumber() const
+{
+    Q_D(const QBExplain);
+    return d->errorNumber;
+}
+
+bool QBExplain::hasErrorOccurred() const
+{
+    Q_D(const QBExplain);
+    return d->errorCode != 0;
+}
+
+void QBExplain::waitForResult()
+{
+    Q_D(QBExplain);
+
+    if ( d->isFinished ) {
+        return;
+    }
+
+    QEventLoop loop;
+    QObject::connect( this, &QBExplain::ready, &loop, &QEventLoop::quit );
+    QObject::connect( this, &QBExplain::error, &loop, &QEventLoop::quit );
+    loop.exec();
+}
+
+void QBExplain::_ar_explain_loaded()
+{
+    Q_D(QBExplain);
+
+    QNetworkReply *reply = qobject_cast<QNetworkReply *>(sender());
+    QJsonObject obj = QJsonDocument::fromJson(reply->readAll()).object();
+    reply->deleteLater();
+
+    d->isFinished = true;
+
+    if ( obj.value(QStringLiteral("error")).toBool() ) {
+        d->errorMessage = obj.value("errorMessage").toString();
+        d->errorNumber  = obj.value("errorNum").toVariant().toInt();
+        d->errorCode    = obj.value("code").toVariant().toInt();
+
+        emit error();
+        return;
+    }
+
+    d->plan = obj.value(QStringLiteral("plan")).toObject();
+
+    for ( const QJsonValue & warning : obj.value(QStringLiteral("warnings")).toArray() ) {
+        d->warnings.append(warning.toObject().value(QStringLiteral("message")).toString());
+    }
+
+    emit ready();
+}
+
+}
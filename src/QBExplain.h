@@ -0,0 +1,226 @@
+/********************************************************************************
+ ** The MIT License (MIT)
+ **
+ ** Copyright (c) 2013 Sascha Ludwig Häusler
+ **
+ ** Permission is hereby granted, free of charge, to any person obtaining a copy of
+ ** this software and associated documentation files (the "Software"), to deal in
+ ** the Software without restriction, including without limitation the rights to
+ ** use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ ** the Software, and to permit persons to whom the Software is furnished to do so,
+ ** subject to the following conditions:
+ **
+ ** The above copyright notice and this permission notice shall be included in all
+ ** copies or substantial portions of the Software.
+ **
+ ** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ ** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ ** FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ ** COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ ** IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ ** CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *********************************************************************************/
+
+#ifndef QBEXPLAIN_H
+#define QBEXPLAIN_H
+
+#include "arangodb-driver_global.h"
+
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonObject>
+#include <QtCore/QObject>
+#include <QtCore/QStringList>
+
+namespace arangodb
+{
+
+class QBExplainPrivate;
+
+/**
+ * @brief The execution plan of a select as the server would run
+ * it, created by Arangodbdriver::explain. The query itself is not
+ * executed.
+ *
+ * @since 0.6
+ */
+class ARANGODBDRIVERSHARED_EXPORT QBExplain : public QObject
+{
+        Q_OBJECT
+    public:
+        /**
+         * @brief QBExplain
+         *
+         * @param parent
+         *
+         * @since 0.6
+         */
+        QBExplain(QObject * parent = 0);
+
+        /**
+         * @brief ~QBExplain
+         *
+         * @since 0.6
+         */
+        virtual ~QBExplain();
+
+        /**
+         * @brief Returns if the plan has been loaded
+         * or an error occurred
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        bool isFinished() const;
+
+        /**
+         * @brief Returns the whole plan as returned by the server
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        QJsonObject plan() const;
+
+        /**
+         * @brief Returns the type of every node of the plan
+         * in execution order
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        QStringList nodeTypes() const;
+
+        /**
+         * @brief estimatedCost
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        double estimatedCost() const;
+
+        /**
+         * @brief estimatedNrItems
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        qint64 estimatedNrItems() const;
+
+        /**
+         * @brief Returns if any collection is read through an index
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        bool usesIndex() const;
+
+        /**
+         * @brief Returns if any collection is read completely
+         * without an index
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        bool isFullScan() const;
+
+        /**
+         * @brief Returns the indexes used by the plan as
+         * "type(field,...)"
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        QStringList indexes() const;
+
+        /**
+         * @brief Returns the warning messages of the optimizer
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        QStringList warnings() const;
+
+        /**
+         * @brief errorMessage
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        QString errorMessage() const;
+
+        /**
+         * @brief errorCode
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        quint32 errorCode() const;
+
+        /**
+         * @brief errorNumber
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        quint32 errorNumber() const;
+
+        /**
+         * @brief hasErrorOccurred
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        bool hasErrorOccurred() const;
+
+        /**
+         * @brief waitForResult
+         *
+         * @since 0.6
+         */
+        void waitForResult();
+
+    public Q_SLOTS:
+        /**
+         * @brief _ar_explain_loaded
+         *
+         * @since 0.6
+         */
+        void _ar_explain_loaded();
+
+    Q_SIGNALS:
+        /**
+         * @brief ready
+         *
+         * @since 0.6
+         */
+        void ready();
+
+        /**
+         * @brief error
+         *
+         * @since 0.6
+         */
+        void error();
+
+    protected:
+        QBExplainPrivate *d_ptr;
+
+    private:
+        Q_DECLARE_PRIVATE(QBExplain)
+};
+
+}
+
+#endif // QBEXPLAIN_H
@@ -0,0 +1,410 @@
+/********************************************************************************
+ ** The MIT License (MIT)
+ **
+ ** Copyright (c) 2013 Sascha Ludwig Häusler
+ **
+ ** Permission is hereby granted, free of charge, to any person obtaining a copy of
+ ** this software and associated documentation files (the "Software"), to deal in
+ ** the Software without restriction, including without limitation the rights to
+ ** use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ ** the Software, and to permit persons to whom the Software is furnished to do so,
+ ** subject to the following conditions:
+ **
+ ** The above copyright notice and this permission notice shall be included in all
+ ** copies or substantial portions of the Software.
+ **
+ ** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ ** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ ** FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ ** COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ ** IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ ** CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *********************************************************************************/
+
+#include "QBParallelScan.h"
+
+#include "Arangodbdriver.h"
+#include "QBCursor.h"
+#include "QBSelect.h"
+
+#include <QtCore/QEventLoop>
+#include <QtCore/QSharedPointer>
+#include <QtCore/QVariant>
+#include <QtCore/QVector>
+
+namespace arangodb
+{
+
+class QBParallelScanPrivate
+{
+    public:
+        Arangodbdriver * driver;
+        QString collection;
+        int parts;
+        int batchSize;
+
+        bool isOrdered = false;
+        bool isStarted = false;
+        bool isFinished = false;
+
+        QStringList boundaries;
+        QSharedPointer<QBCursor> countCursor;
+        QSharedPointer<QBCursor> keyCursor;
+
+        struct Part {
+            QSharedPointer<QBCursor> cursor;
+            bool hasPendingBatch = false;
+            bool isDone = false;
+            bool isPaused = false;
+        };
+
+        QVector<Part> partList;
+        int currentPart = 0;
+        int finishedParts = 0;
+        qint64 count = 0;
+
+        QString errorMessage;
+        bool hasError = false;
+
+        inline int indexOf(QBCursor * cursor) const {
+            const int total = partList.size();
+            for (int i = 0; i < total; ++i) {
+                if ( partList.at(i).cursor.data() == cursor ) return i;
+            }
+
+            return -1;
+        }
+
+        inline bool isFetching(int part) const {
+            const Part & p = partList.at(part);
+            return !p.isDone && !p.isPaused && !p.hasPendingBatch;
+        }
+};
+
+QBParallelScan::QBParallelScan(Arangodbdriver * driver, const QString & collection, int parts, int batchSize, QObject * parent) :
+    QObject(parent),
+    d_ptr(new QBParallelScanPrivate)
+{
+    Q_D(QBParallelScan);
+    d->driver = driver;
+    d->collection = collection;
+    d->parts = qMax(parts, 1);
+    d->batchSize = batchSize;
+}
+
+QBParallelScan::~QBParallelScan()
+{
+    delete d_ptr;
+}
+
+void QBParallelScan::setKeyBoundaries(const QStringList & boundaries)
+{
+    Q_D(QBParallelScan);
+    d->boundaries = boundaries;
+}
+
+QStringList QBParallelScan::keyBoundaries() const
+{
+    Q_D(const QBParallelScan);
+    return d->boundaries;
+}
+
+void QBParallelScan::setOrdered(bool ordered)
+{
+    Q_D(QBParallelScan);
+    d->isOrdered = ordered;
+}
+
+bool QBParallelScan::isOrdered() const
+{
+    Q_D(const QBParallelScan);
+    return d->isOrdered;
+}
+
+void QBParallelScan::start()
+{
+    Q_D(QBParallelScan);
+
+    if ( d->isStarted ) {
+        return;
+    }
+
+    d->isStarted = true;
+
+    if ( d->parts < 2 || !d->boundaries.isEmpty() ) {
+        startParts();
+        return;
+    }
+
+    // The boundaries are read at evenly spaced offsets of the
+    // primary index, which first needs the number of documents
+    QVariantMap bindVars;
+    bindVars.insert(QStringLiteral("@collection"), d->collection);
+
+    d->countCursor = d->driver->executeQuery(QStringLiteral(
+        "RETURN { count: LENGTH(@@collection) }"), bindVars);
+
+    connect(d->countCursor.data(), &QBCursor::ready,
+            this, &QBParallelScan::_ar_count_loaded
+            );
+    connect(d->countCursor.data(), &QBCursor::error,
+            this, &QBParallelScan::_ar_part_error
+            );
+}
+
+bool QBParallelScan::isFinished() const
+{
+    Q_D(const QBParallelScan);
+    return d->isFinished;
+}
+
+qint64 QBParallelScan::count() const
+{
+    Q_D(const QBParallelScan);
+    return d->count;
+}
+
+QString QBParallelScan::errorMessage() const
+{
+    Q_D(const QBParallelScan);
+    return d->errorMessage;
+}
+
+bool QBParallelScan::hasErrorOccurred() const
+{
+    Q_D(const QBParallelScan);
+    return d->hasError;
+}
+
+void QBParallelScan::waitUntilFinished()
+{
+    Q_D(QBParallelScan);
+
+    if ( d->isFinished || d->hasError ) {
+        return;
+    }
+
+    QEventLoop loop;
+    QObject::connect( this, &QBParallelScan::finished, &loop, &QEventLoop::quit );
+    QObject::connect( this, &QBParallelScan::error, &loop, &QEventLoop::quit );
+    loop.exec();
+}
+
+void QBParallelScan::_ar_count_loaded()
+{
+    Q_D(QBParallelScan);
+
+    const QList<Document *> rows = d->countCursor->data();
+    const qint64 total = rows.isEmpty() ? 0 : rows.first()->get(QStringLiteral("count")).toLongLong();
+    d->countCursor->clearData();
+
+    // Offsets below one or equal to the previous one
+    // would only create empty ranges
+    QList<qint64> offsets;
+    for (int i = 1; i < d->parts; ++i) {
+        const qint64 offset = total * i / d->parts;
+        if ( offset > 0 && (offsets.isEmpty() || offsets.last() != offset) ) {
+            offsets.append(offset);
+        }
+    }
+
+    if ( offsets.isEmpty() ) {
+        startParts();
+        return;
+    }
+
+    // Every key is searched from the previous one on, so the primary
+    // index is walked only once and the documents are not read at all
+    QVariantMap bindVars;
+    bindVars.insert(QStringLiteral("@collection"), d->collection);
+
+    QString query;
+    QStringList keys;
+    for (int i = 0; i < offsets.size(); ++i) {
+        const QString key = QStringLiteral("key%1").arg(i);
+        const QString skip = QStringLiteral("skip%1").arg(i);
+
+        query += QStringLiteral("LET %1 = FIRST(FOR doc IN @@collection ").arg(key);
+        if ( i > 0 ) {
+            query += QStringLiteral("FILTER doc._key > %1 ").arg(keys.last());
+        }
+        query += QStringLiteral("SORT doc._key LIMIT @%1, 1 RETURN doc._key) ").arg(skip);
+
+        bindVars.insert(skip, (i == 0) ? offsets.at(i) : offsets.at(i) - offsets.at(i - 1) - 1);
+        keys.append(key);
+    }
+
+    query += QStringLiteral("FOR key IN [%1] FILTER key != null RETURN { _key: key }")
+             .arg(keys.join(QStringLiteral(", ")));
+
+    d->keyCursor = d->driver->executeQuery(query, bindVars);
+
+    connect(d->keyCursor.data(), &QBCursor::ready,
+            this, &QBParallelScan::_ar_keys_loaded
+            );
+    connect(d->keyCursor.data(), &QBCursor::error,
+            this, &QBParallelScan::_ar_part_error
+            );
+}
+
+void QBParallelScan::_ar_keys_loaded()
+{
+    Q_D(QBParallelScan);
+
+    if ( d->keyCursor->hasMore() ) {
+        d->keyCursor->getMoreData();
+        return;
+    }
+
+    // Already in server order, equal neighbours in small
+    // collections would only create empty ranges
+    for ( Document * doc : d->keyCursor->data() ) {
+        const QString boundary = doc->key();
+        if ( d->boundaries.isEmpty() || d->boundaries.last() != boundary ) {
+            d->boundaries.append(boundary);
+        }
+    }
+
+    d->keyCursor->clearData();
+    startParts();
+}
+
+void QBParallelScan::_ar_part_loaded()
+{
+    Q_D(QBParallelScan);
+
+    if ( d->hasError ) {
+        return;
+    }
+
+    const int part = d->indexOf(qobject_cast<QBCursor *>(sender()));
+    if ( part < 0 ) {
+        return;
+    }
+
+    if ( !d->isOrdered || part == d->currentPart ) {
+        deliver(part);
+    }
+    else {
+        d->partList[part].hasPendingBatch = true;
+        resumeParts();
+    }
+}
+
+void QBParallelScan::_ar_part_error()
+{
+    Q_D(QBParallelScan);
+
+    // Only the first failing range is reported
+    if ( d->hasError ) {
+        return;
+    }
+
+    QBCursor * cursor = qobject_cast<QBCursor *>(sender());
+    d->hasError = true;
+    d->errorMessage = cursor->errorMessage();
+
+    // The other ranges are of no use anymore
+    for ( auto & part : d->partList ) {
+        part.cursor->dispose();
+    }
+
+    Q_EMIT error();
+}
+
+void QBParallelScan::startParts()
+{
+    Q_D(QBParallelScan);
+
+    const int total = d->boundaries.size() + 1;
+    d->partList.resize(total);
+
+    for (int i = 0; i < total; ++i) {
+        QSharedPointer<QBSelect> select(new QBSelect(d->collection, d->batchSize));
+        select->setKeyRange((i == 0) ? QString() : d->boundaries.at(i - 1),
+                            (i == total - 1) ? QString() : d->boundaries.at(i));
+
+        QSharedPointer<QBCursor> cursor = d->driver->executeSelect(select);
+        cursor->setBatchRecycling(true);
+
+        connect(cursor.data(), &QBCursor::ready,
+                this, &QBParallelScan::_ar_part_loaded
+                );
+        connect(cursor.data(), &QBCursor::error,
+                this, &QBParallelScan::_ar_part_error
+                );
+
+        d->partList[i].cursor = cursor;
+    }
+}
+
+void QBParallelScan::deliver(int part)
+{
+    Q_D(QBParallelScan);
+
+    QBCursor * cursor = d->partList.at(part).cursor.data();
+    QList<Document *> docs = cursor->data();
+
+    if ( !docs.isEmpty() ) {
+        d->count += docs.size();
+        Q_EMIT documentsAvailable(part, docs);
+    }
+
+    if ( cursor->hasMore() ) {
+        d->partList[part].isPaused = true;
+        resumeParts();
+        return;
+    }
+
+    d->partList[part].isDone = true;
+    d->finishedParts++;
+    resumeParts();
+
+    if ( d->finishedParts == d->partList.size() ) {
+        d->isFinished = true;
+        Q_EMIT finished();
+        return;
+    }
+
+    // The next range might already wait with its first batch
+    if ( d->isOrdered && part == d->currentPart ) {
+        while ( ++d->currentPart < d->partList.size() ) {
+            if ( d->partList.at(d->currentPart).hasPendingBatch ) {
+                d->partList[d->currentPart].hasPendingBatch = false;
+                deliver(d->currentPart);
+                return;
+            }
+
+            if ( !d->partList.at(d->currentPart).isDone ) {
+                return;
+            }
+        }
+    }
+}
+
+void QBParallelScan::resumeParts()
+{
+    Q_D(QBParallelScan);
+
+    const int total = d->partList.size();
+    const bool isOverLimit = d->driver->isOverMemoryLimit();
+
+    int fetching = 0;
+    for (int i = 0; i < total; ++i) {
+        if ( d->isFetching(i) ) ++fetching;
+    }
+
+    // Under memory pressure only one range is loaded at a time,
+    // in ordered mode the range which is delivered next goes first
+    for (int n = 0; n < total; ++n) {
+        const int part = (d->currentPart + n) % total;
+        if ( !d->partList.at(part).isPaused ) continue;
+        if ( isOverLimit && fetching > 0 ) break;
+
+        d->partList[part].isPaused = false;
+        d->partList.at(part).cursor->getMoreData();
+        ++fetching;
+    }
+}
+
+}
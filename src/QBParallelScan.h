@@ -0,0 +1,243 @@
+/********************************************************************************
+ ** The MIT License (MIT)
+ **
+ ** Copyright (c) 2013 Sascha Ludwig Häusler
+ **
+ ** Permission is hereby granted, free of charge, to any person obtaining a copy of
+ ** this software and associated documentation files (the "Software"), to deal in
+ ** the Software without restriction, including without limitation the rights to
+ ** use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ ** the Software, and to permit persons to whom the Software is furnished to do so,
+ ** subject to the following conditions:
+ **
+ ** The above copyright notice and this permission notice shall be included in all
+ ** copies or substantial portions of the Software.
+ **
+ ** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ ** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ ** FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ ** COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ ** IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ ** CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *********************************************************************************/
+
+#ifndef QBPARALLELSCAN_H
+#define QBPARALLELSCAN_H
+
+#include "arangodb-driver_global.h"
+#include "Document.h"
+
+#include <QtCore/QList>
+#include <QtCore/QStringList>
+
+namespace arangodb
+{
+
+class Arangodbdriver;
+class QBParallelScanPrivate;
+
+/**
+ * @brief Scans a whole collection with several cursors at
+ * once. The collection is split into disjoint _key ranges and
+ * every range is read by its own cursor, so the batches are
+ * loaded over as many connections as the network manager
+ * opens to the server. All batches are delivered through
+ * the documentsAvailable signal.
+ *
+ * The documents are owned by the scan and are only valid
+ * until the slot connected to documentsAvailable returns.
+ *
+ * While the driver is above its memory soft limit (see
+ * Arangodbdriver::setMemorySoftLimit) only one range is
+ * loaded at a time.
+ *
+ * @since 0.6
+ */
+class ARANGODBDRIVERSHARED_EXPORT QBParallelScan : public QObject
+{
+        Q_OBJECT
+    public:
+        /**
+         * @brief QBParallelScan
+         *
+         * @param driver
+         * @param collection
+         * @param parts         Number of ranges and cursors
+         * @param batchSize
+         * @param parent
+         *
+         * @since 0.6
+         */
+        QBParallelScan(Arangodbdriver * driver,
+                       const QString & collection,
+                       int parts,
+                       int batchSize = 1000,
+                       QObject * parent = 0);
+
+        /**
+         * @brief ~QBParallelScan
+         *
+         * @since 0.6
+         */
+        virtual ~QBParallelScan();
+
+        /**
+         * @brief Sets the parts - 1 sorted keys where the ranges
+         * are split. If no boundaries are set, the documents are
+         * counted and the keys which split them evenly are read
+         * by skipping along the primary index.
+         *
+         * @param boundaries
+         *
+         * @since 0.6
+         */
+        void setKeyBoundaries(const QStringList & boundaries);
+
+        /**
+         * @brief keyBoundaries
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        QStringList keyBoundaries() const;
+
+        /**
+         * @brief If set, the batches are delivered range after range
+         * in key order. Ranges ahead of the current one load their
+         * first batch and wait until it is their turn.
+         *
+         * @param ordered
+         *
+         * @since 0.6
+         */
+        void setOrdered(bool ordered);
+
+        /**
+         * @brief isOrdered
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        bool isOrdered() const;
+
+        /**
+         * @brief Starts the scan
+         *
+         * @since 0.6
+         */
+        void start();
+
+        /**
+         * @brief isFinished
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        bool isFinished() const;
+
+        /**
+         * @brief Number of documents delivered so far
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        qint64 count() const;
+
+        /**
+         * @brief errorMessage
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        QString errorMessage() const;
+
+        /**
+         * @brief hasErrorOccurred
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        bool hasErrorOccurred() const;
+
+        /**
+         * @brief Waits until either the finished or the error
+         * signal has been emitted
+         *
+         * @since 0.6
+         */
+        void waitUntilFinished();
+
+    Q_SIGNALS:
+        /**
+         * @brief documentsAvailable
+         *
+         * @param part
+         * @param docs
+         *
+         * @since 0.6
+         */
+        void documentsAvailable(int part, QList<arangodb::Document *> docs);
+
+        /**
+         * @brief finished
+         *
+         * @since 0.6
+         */
+        void finished();
+
+        /**
+         * @brief error
+         *
+         * @since 0.6
+         */
+        void error();
+
+    protected Q_SLOTS:
+        /**
+         * @brief _ar_count_loaded
+         *
+         * @since 0.6
+         */
+        void _ar_count_loaded();
+
+        /**
+         * @brief _ar_keys_loaded
+         *
+         * @since 0.6
+         */
+        void _ar_keys_loaded();
+
+        /**
+         * @brief _ar_part_loaded
+         *
+         * @since 0.6
+         */
+        void _ar_part_loaded();
+
+        /**
+         * @brief _ar_part_error
+         *
+         * @since 0.6
+         */
+        void _ar_part_error();
+
+    protected:
+        QBParallelScanPrivate *d_ptr;
+
+    private:
+        void startParts();
+        void deliver(int part);
+        void resumeParts();
+
+        Q_DECLARE_PRIVATE(QBParallelScan)
+};
+
+}
+
+#endif // QBPARALLELSCAN_H
@@ -37,11 +37,97 @@ class QBSelectPrivate
         QStringList collections;
         int batchSize;
         int limit;
+        int ttl = -1;
         bool isCounting;
+        bool isColumnar = false;
+        bool isProfiling = false;
+        bool isFullCount = false;
 
         QString where;
-        QString whereField;
-        QStringList bindVars;
+        QList<QStringList> whereGroups;
+        QStringList whereBindVars;
+        QVariantMap bindVars;
+
+        QString keyFrom;
+        QString keyTo;
+
+        int offset = 0;
+
+        /**
+         * @brief A field to sort by, rendered when the query is built
+         * so the names of a collect can be sorted by
+         *
+         * @since 0.6
+         */
+        struct SortField {
+            QString collection;
+            QString field;
+            QBSelect::SortDirection direction;
+        };
+
+        QList<SortField> sortFields;
+
+        QStringList collectNames;
+        QStringList collectGroups;
+        QStringList aggregateNames;
+        QStringList aggregates;
+        QString countInto;
+
+        /**
+         * @since 0.6
+         */
+        inline bool isCollecting() const {
+            return !collectGroups.isEmpty() || !aggregates.isEmpty() || !countInto.isEmpty();
+        }
+
+        /**
+         * @brief Builds the COLLECT statement. When aggregates are used,
+         * the count is also an aggregate, because AQL does not allow
+         * WITH COUNT INTO together with AGGREGATE.
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        inline QString buildCollect() const {
+            QString collect = QStringLiteral("COLLECT");
+            if ( !collectGroups.isEmpty() ) {
+                collect += QChar(' ') + collectGroups.join(QStringLiteral(", "));
+            }
+
+            if ( !aggregates.isEmpty() ) {
+                QStringList allAggregates = aggregates;
+                if ( !countInto.isEmpty() ) {
+                    allAggregates.append(QStringLiteral("%1 = LENGTH(1)").arg(countInto));
+                }
+                collect += QStringLiteral(" AGGREGATE ") + allAggregates.join(QStringLiteral(", "));
+            }
+            else if ( !countInto.isEmpty() ) {
+                collect += QStringLiteral(" WITH COUNT INTO ") + countInto;
+            }
+
+            return collect;
+        }
+
+        /**
+         * @brief Returns an object with all grouping, aggregate
+         * and count names
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        inline QString getCollectResult() const {
+            QStringList names = collectNames + aggregateNames;
+            if ( !countInto.isEmpty() ) names.append(countInto);
+
+            QStringList parts;
+            for ( const QString & name : names ) {
+                parts.append(QStringLiteral("\"%1\": %1").arg(name));
+            }
+
+            return QChar('{') + parts.join(QChar(',')) + QChar('}');
+        }
 
         QVariant result;
 
@@ -55,11 +141,185 @@ class QBSelectPrivate
             NoResult            = 0,
             StringResult        = 1,
             StringListResult    = 2,
-            HashResult          = 3
+            HashResult          = 3,
+            ProjectionResult    = 4
         };
 
         ResultType resultType = ResultType::NoResult;
 
+        /**
+         * @brief Binds the value of a where condition and returns
+         * the name of the bind parameter for the query. The names
+         * only depend on the order of the values, so the query
+         * text is the same for every value.
+         *
+         * @param value
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        inline QString bindWhereValue(const QVariant & value) {
+            QString name = QStringLiteral("value%1").arg(whereBindVars.size());
+            whereBindVars.append(name);
+            bindVars.insert(name, value);
+            return QChar('@') + name;
+        }
+
+        /**
+         * @brief Removes the bind parameters of the where condition
+         *
+         * @since 0.6
+         */
+        inline void clearWhereBindVars() {
+            for ( const QString & name : whereBindVars ) {
+                bindVars.remove(name);
+            }
+            whereBindVars.clear();
+        }
+
+        /**
+         * @brief Sets the where condition. The prepared query is only
+         * thrown away if the condition text changed, so setting
+         * only another value keeps it.
+         *
+         * @param condition
+         *
+         * @since 0.6
+         */
+        inline void setWhereCondition(const QString & condition) {
+            if ( condition != where ) {
+                where = condition;
+                isPrepared = false;
+            }
+        }
+
+        /**
+         * @brief Adds a condition to the last group of conditions
+         * or starts a new group with it
+         *
+         * @param condition
+         * @param startsGroup
+         *
+         * @since 0.6
+         */
+        inline void addWhereCondition(const QString & condition, bool startsGroup) {
+            if ( startsGroup || whereGroups.isEmpty() ) {
+                whereGroups.append(QStringList());
+            }
+
+            whereGroups.last().append(condition);
+            updateWhere();
+        }
+
+        /**
+         * @brief Removes all conditions and their bind parameters
+         *
+         * @since 0.6
+         */
+        inline void clearWhereConditions() {
+            clearWhereBindVars();
+            whereGroups.clear();
+        }
+
+        /**
+         * @brief Builds the filter statement out of the groups,
+         * the conditions of a group are joined with AND and the
+         * groups with OR
+         *
+         * @since 0.6
+         */
+        inline void updateWhere() {
+            QStringList groups;
+            for ( const QStringList & group : whereGroups ) {
+                QString joined = group.join(QStringLiteral(" AND "));
+                if ( whereGroups.size() > 1 && group.size() > 1 ) {
+                    joined = QChar('(') + joined + QChar(')');
+                }
+                groups.append(joined);
+            }
+
+            setWhereCondition(groups.isEmpty() ? QString()
+                                               : QStringLiteral("FILTER ") + groups.join(QStringLiteral(" OR ")));
+        }
+
+        /**
+         * @brief Returns the condition for the field compared
+         * to a new bind parameter
+         *
+         * @param collection
+         * @param field
+         * @param op
+         * @param value
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        inline QString buildCondition(const QString & collection, const QString & field,
+                                      QBSelect::Operator op, const QVariant & value) {
+            const QString attribute = getCollectionIdentifier(collection) + QChar('.') + field;
+            const QString bindName = bindWhereValue(value);
+
+            switch (op)
+            {
+                case QBSelect::Operator::NotEqual:
+                    return QStringLiteral("%1 != %2").arg(attribute, bindName);
+                case QBSelect::Operator::Less:
+                    return QStringLiteral("%1 < %2").arg(attribute, bindName);
+                case QBSelect::Operator::LessEqual:
+                    return QStringLiteral("%1 <= %2").arg(attribute, bindName);
+                case QBSelect::Operator::Greater:
+                    return QStringLiteral("%1 > %2").arg(attribute, bindName);
+                case QBSelect::Operator::GreaterEqual:
+                    return QStringLiteral("%1 >= %2").arg(attribute, bindName);
+                case QBSelect::Operator::In:
+                    return QStringLiteral("%1 IN %2").arg(attribute, bindName);
+                case QBSelect::Operator::NotIn:
+                    return QStringLiteral("%1 NOT IN %2").arg(attribute, bindName);
+                case QBSelect::Operator::Like:
+                    return QStringLiteral("LIKE(%1, %2)").arg(attribute, bindName);
+                case QBSelect::Operator::Equal:
+                default:
+                    return QStringLiteral("%1 == %2").arg(attribute, bindName);
+            }
+        }
+
+        mutable bool isPrepared = false;
+        mutable QJsonObject preparedJson;
+
+        /**
+         * @brief Builds the query text and the json object around
+         * it without the bind parameters
+         *
+         * @since 0.6
+         */
+        inline void prepare() const {
+            preparedJson = QJsonObject();
+            preparedJson.insert(QStringLiteral("query"), buildQuery());
+            preparedJson.insert(QStringLiteral("count"), isCounting);
+            preparedJson.insert(QStringLiteral("batchSize"), batchSize);
+            if ( ttl > 0 ) preparedJson.insert(QStringLiteral("ttl"), ttl);
+
+            if ( isProfiling || isFullCount ) {
+                QJsonObject options;
+                if ( isProfiling ) options.insert(QStringLiteral("profile"), true);
+                if ( isFullCount ) options.insert(QStringLiteral("fullCount"), true);
+                preparedJson.insert(QStringLiteral("options"), options);
+            }
+
+            isPrepared = true;
+        }
+
+        /**
+         * @brief buildQuery
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        QString buildQuery() const;
+
         /**
          * @brief getResult
          *
@@ -112,6 +372,17 @@ class QBSelectPrivate
                     }
                     break;
 
+                case ResultType::ProjectionResult: {
+                        QStringList parts;
+                        const QString identifier = getCollectionIdentifier(getCollectionName());
+                        for ( const QString & field : result.toStringList() ) {
+                            parts.append(QStringLiteral("\"%1\": %2.%1").arg(field, identifier));
+                        }
+
+                        realResult = QChar('{') + parts.join(QChar(',')) + QChar('}');
+                    }
+                    break;
+
                 default:
                     break;
             }
@@ -221,8 +492,10 @@ QBSelect::~QBSelect()
 void QBSelect::addNewCollection(const QString & collection)
 {
     Q_D(QBSelect);
-    if ( !d->collections.contains(collection) )
+    if ( !d->collections.contains(collection) ) {
         d->collections.append(collection);
+        d->isPrepared = false;
+    }
 }
 
 QStringList QBSelect::collections() const
@@ -237,10 +510,24 @@ int QBSelect::batchSize() const
     return d->batchSize;
 }
 
+void QBSelect::setTtl(int seconds)
+{
+    Q_D(QBSelect);
+    d->ttl = seconds;
+    d->isPrepared = false;
+}
+
+int QBSelect::ttl() const
+{
+    Q_D(const QBSelect);
+    return d->ttl;
+}
+
 void QBSelect::setCounting(bool c)
 {
     Q_D(QBSelect);
     d->isCounting = c;
+    d->isPrepared = false;
 }
 
 bool QBSelect::isCounting() const
@@ -252,25 +539,22 @@ bool QBSelect::isCounting() const
 void QBSelect::setWhere(const QString & field, const QString & op)
 {
     Q_D(QBSelect);
-    QString collectionIdentifier = d->getCollectionIdentifier(d->getCollectionName());
-    d->where = QStringLiteral("FILTER %1.%2 == \"%3\"").arg(collectionIdentifier, field, op);
+    d->clearWhereConditions();
+    d->addWhereCondition(d->buildCondition(d->getCollectionName(), field, Operator::Equal, op), false);
 }
 
 void QBSelect::setWhere(const QString & field, bool op)
 {
     Q_D(QBSelect);
-    QString collectionIdentifier = d->getCollectionIdentifier(d->getCollectionName());
-    if (op) d->where = QStringLiteral("FILTER %1.%2 == true").arg(collectionIdentifier, field);
-    else d->where = QStringLiteral("FILTER %1.%2 == false").arg(collectionIdentifier, field);
+    d->clearWhereConditions();
+    d->addWhereCondition(d->buildCondition(d->getCollectionName(), field, Operator::Equal, op), false);
 }
 
 void QBSelect::setWhere(const QString & field, const QStringList & op)
 {
     Q_D(QBSelect);
-    QString collectionIdentifier = d->getCollectionIdentifier(d->getCollectionName());
-    d->bindVars = op;
-    d->where = QStringLiteral("FILTER %1.%2 IN %3").arg(collectionIdentifier, field, QChar('@') + field);
-    d->whereField = field;
+    d->clearWhereConditions();
+    d->addWhereCondition(d->buildCondition(d->getCollectionName(), field, Operator::In, op), false);
 }
 
 void QBSelect::setWhere(const QString & collection1, const QString & field1,
@@ -279,7 +563,114 @@ void QBSelect::setWhere(const QString & collection1, const QString & field1,
     Q_D(QBSelect);
     QString identifier1 = d->getCollectionIdentifier(collection1);
     QString identifier2 = d->getCollectionIdentifier(collection2);
-    d->where = QStringLiteral("FILTER %1.%2 == %3.%4").arg(identifier1, field1, identifier2, field2);
+    d->clearWhereConditions();
+    d->addWhereCondition(QStringLiteral("%1.%2 == %3.%4").arg(identifier1, field1, identifier2, field2), false);
+}
+
+void QBSelect::andWhere(const QString & field, Operator op, const QVariant & value)
+{
+    Q_D(QBSelect);
+    d->addWhereCondition(d->buildCondition(d->getCollectionName(), field, op, value), false);
+}
+
+void QBSelect::andWhere(const QString & collection, const QString & field, Operator op, const QVariant & value)
+{
+    Q_D(QBSelect);
+    d->addWhereCondition(d->buildCondition(collection, field, op, value), false);
+}
+
+void QBSelect::orWhere(const QString & field, Operator op, const QVariant & value)
+{
+    Q_D(QBSelect);
+    d->addWhereCondition(d->buildCondition(d->getCollectionName(), field, op, value), true);
+}
+
+void QBSelect::orWhere(const QString & collection, const QString & field, Operator op, const QVariant & value)
+{
+    Q_D(QBSelect);
+    d->addWhereCondition(d->buildCondition(collection, field, op, value), true);
+}
+
+void QBSelect::andWhereExpression(const QString & expression)
+{
+    Q_D(QBSelect);
+    // Parenthesized, so an OR inside does not leak into the group
+    d->addWhereCondition(QChar('(') + expression + QChar(')'), false);
+}
+
+void QBSelect::orWhereExpression(const QString & expression)
+{
+    Q_D(QBSelect);
+    d->addWhereCondition(QChar('(') + expression + QChar(')'), true);
+}
+
+QString QBSelect::documentVariable(const QString & collection) const
+{
+    Q_D(const QBSelect);
+    return d->getCollectionIdentifier(collection.isEmpty() ? d->getCollectionName() : collection);
+}
+
+void QBSelect::clearWhere()
+{
+    Q_D(QBSelect);
+    d->clearWhereConditions();
+    d->updateWhere();
+}
+
+bool QBSelect::setBindVar(const QString & name, const QVariant & value)
+{
+    Q_D(QBSelect);
+
+    if ( isReservedBindVar(name) ) {
+        qWarning() << Q_FUNC_INFO;
+        qWarning() << "Bind parameter name is reserved:" << name;
+        return false;
+    }
+
+    d->bindVars.insert(name, value);
+    return true;
+}
+
+bool QBSelect::isReservedBindVar(const QString & name)
+{
+    if ( name == QStringLiteral("keyFrom") || name == QStringLiteral("keyTo")
+         || name == QStringLiteral("limitOffset") || name == QStringLiteral("limitCount") ) {
+        return true;
+    }
+
+    // value0, value1, ... of the where conditions
+    const QString prefix = QStringLiteral("value");
+    if ( !name.startsWith(prefix) || name.size() == prefix.size() ) {
+        return false;
+    }
+
+    for (int i = prefix.size(); i < name.size(); ++i) {
+        if ( !name.at(i).isDigit() ) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+QVariantMap QBSelect::bindVars() const
+{
+    Q_D(const QBSelect);
+    return d->bindVars;
+}
+
+void QBSelect::setKeyRange(const QString & from, const QString & to)
+{
+    Q_D(QBSelect);
+    d->keyFrom = from;
+    d->keyTo = to;
+    d->isPrepared = false;
+
+    if ( from.isEmpty() ) d->bindVars.remove(QStringLiteral("keyFrom"));
+    else d->bindVars.insert(QStringLiteral("keyFrom"), from);
+
+    if ( to.isEmpty() ) d->bindVars.remove(QStringLiteral("keyTo"));
+    else d->bindVars.insert(QStringLiteral("keyTo"), to);
 }
 
 void QBSelect::setResult(const QString & collectionName)
@@ -287,6 +678,7 @@ void QBSelect::setResult(const QString & collectionName)
     Q_D(QBSelect);
     d->result = collectionName;
     d->resultType = QBSelectPrivate::ResultType::StringResult;
+    d->isPrepared = false;
 }
 
 void QBSelect::setResult(const QStringList & collectionNames)
@@ -294,6 +686,7 @@ void QBSelect::setResult(const QStringList & collectionNames)
     Q_D(QBSelect);
     d->result = collectionNames;
     d->resultType = QBSelectPrivate::ResultType::StringListResult;
+    d->isPrepared = false;
 }
 
 void QBSelect::setResult(const QHash<QString, QVariant> & collectionFields)
@@ -301,51 +694,308 @@ void QBSelect::setResult(const QHash<QString, QVariant> & collectionFields)
     Q_D(QBSelect);
     d->result = collectionFields;
     d->resultType = QBSelectPrivate::ResultType::HashResult;
+    d->isPrepared = false;
+}
+
+void QBSelect::setLimit(int count)
+{
+    setLimit(0, count);
+}
+
+void QBSelect::setLimit(int offset, int count)
+{
+    Q_D(QBSelect);
+
+    if ( (d->limit > 0) != (count > 0) ) {
+        d->isPrepared = false;
+    }
+
+    d->limit = count;
+    d->offset = qMax(offset, 0);
+
+    if ( count > 0 ) {
+        d->bindVars.insert(QStringLiteral("limitOffset"), d->offset);
+        d->bindVars.insert(QStringLiteral("limitCount"), count);
+    }
+    else {
+        d->bindVars.remove(QStringLiteral("limitOffset"));
+        d->bindVars.remove(QStringLiteral("limitCount"));
+    }
+}
+
+int QBSelect::limit() const
+{
+    Q_D(const QBSelect);
+    return d->limit;
+}
+
+int QBSelect::offset() const
+{
+    Q_D(const QBSelect);
+    return d->offset;
+}
+
+void QBSelect::setSort(const QString & field, SortDirection direction)
+{
+    clearSort();
+    addSort(field, direction);
+}
+
+void QBSelect::addSort(const QString & field, SortDirection direction)
+{
+    Q_D(QBSelect);
+    addSort(d->getCollectionName(), field, direction);
+}
+
+void QBSelect::addSort(const QString & collection, const QString & field, SortDirection direction)
+{
+    Q_D(QBSelect);
+    d->sortFields.append({collection, field, direction});
+    d->isPrepared = false;
+}
+
+void QBSelect::clearSort()
+{
+    Q_D(QBSelect);
+    if ( !d->sortFields.isEmpty() ) {
+        d->sortFields.clear();
+        d->isPrepared = false;
+    }
+}
+
+void QBSelect::setCollect(const QString & field, const QString & name)
+{
+    clearCollect();
+    addCollect(field, name);
+}
+
+void QBSelect::addCollect(const QString & field, const QString & name)
+{
+    Q_D(QBSelect);
+    addCollect(d->getCollectionName(), field, name);
+}
+
+void QBSelect::addCollect(const QString & collection, const QString & field, const QString & name)
+{
+    Q_D(QBSelect);
+    const QString groupName = name.isEmpty() ? field : name;
+    d->collectNames.append(groupName);
+    d->collectGroups.append(QStringLiteral("%1 = %2.%3").arg(groupName,
+                                                             d->getCollectionIdentifier(collection),
+                                                             field));
+    d->isPrepared = false;
+}
+
+void QBSelect::addAggregate(const QString & name, AggregateFunction function, const QString & field)
+{
+    Q_D(QBSelect);
+
+    QString functionName;
+    switch (function)
+    {
+        case AggregateFunction::Sum:
+            functionName = QStringLiteral("SUM");
+            break;
+        case AggregateFunction::Min:
+            functionName = QStringLiteral("MIN");
+            break;
+        case AggregateFunction::Max:
+            functionName = QStringLiteral("MAX");
+            break;
+        case AggregateFunction::Average:
+            functionName = QStringLiteral("AVERAGE");
+            break;
+        case AggregateFunction::CountDistinct:
+            functionName = QStringLiteral("COUNT_DISTINCT");
+            break;
+        case AggregateFunction::Count:
+        default:
+            functionName = QStringLiteral("LENGTH");
+            break;
+    }
+
+    const QString argument = field.isEmpty() ? QStringLiteral("1")
+                                             : d->getCollectionIdentifier(d->getCollectionName()) + QChar('.') + field;
+
+    d->aggregateNames.append(name);
+    d->aggregates.append(QStringLiteral("%1 = %2(%3)").arg(name, functionName, argument));
+    d->isPrepared = false;
+}
+
+void QBSelect::setCountInto(const QString & name)
+{
+    Q_D(QBSelect);
+    if ( d->countInto != name ) {
+        d->countInto = name;
+        d->isPrepared = false;
+    }
+}
+
+void QBSelect::clearCollect()
+{
+    Q_D(QBSelect);
+    if ( d->isCollecting() ) {
+        d->collectNames.clear();
+        d->collectGroups.clear();
+        d->aggregateNames.clear();
+        d->aggregates.clear();
+        d->countInto.clear();
+        d->isPrepared = false;
+    }
+}
+
+bool QBSelect::isCollecting() const
+{
+    Q_D(const QBSelect);
+    return d->isCollecting();
+}
+
+void QBSelect::setProjection(const QStringList & fields)
+{
+    Q_D(QBSelect);
+    d->result = fields;
+    d->resultType = QBSelectPrivate::ResultType::ProjectionResult;
+    d->isPrepared = false;
+}
+
+void QBSelect::setColumnar(bool columnar)
+{
+    Q_D(QBSelect);
+    d->isColumnar = columnar;
+}
+
+bool QBSelect::isColumnar() const
+{
+    Q_D(const QBSelect);
+    return d->isColumnar;
+}
+
+void QBSelect::setProfiling(bool profiling)
+{
+    Q_D(QBSelect);
+    if ( d->isProfiling != profiling ) {
+        d->isProfiling = profiling;
+        d->isPrepared = false;
+    }
+}
+
+bool QBSelect::isProfiling() const
+{
+    Q_D(const QBSelect);
+    return d->isProfiling;
+}
+
+void QBSelect::setFullCount(bool fullCount)
+{
+    Q_D(QBSelect);
+    if ( d->isFullCount != fullCount ) {
+        d->isFullCount = fullCount;
+        d->isPrepared = false;
+    }
+}
+
+bool QBSelect::isFullCount() const
+{
+    Q_D(const QBSelect);
+    return d->isFullCount;
+}
+
+QString QBSelect::query() const
+{
+    Q_D(const QBSelect);
+
+    if ( !d->isPrepared ) {
+        d->prepare();
+    }
+
+    return d->preparedJson.value(QStringLiteral("query")).toString();
+}
+
+void QBSelect::prepare() const
+{
+    Q_D(const QBSelect);
+    d->prepare();
+}
+
+bool QBSelect::isPrepared() const
+{
+    Q_D(const QBSelect);
+    return d->isPrepared;
 }
 
 QByteArray QBSelect::toJson() const
 {
     Q_D(const QBSelect);
-    QJsonDocument jsonDoc;
-    QJsonObject jsonObj;
-    const QString forCollectionTemplate("FOR %1 IN %2 ");
-    QString query("FOR %1 IN %2 %3 %4 RETURN %5");
-
-    const int totalCollections = d->collections.size();
-    for (int i = 0; i < totalCollections-1; ++i) {
-        QString collection = forCollectionTemplate;
-        QString collectionName = d->collections.at(i);
-        collection = collection.arg(d->getCollectionIdentifier(collectionName), collectionName);
-        query = collection + query;
+
+    if ( !d->isPrepared ) {
+        d->prepare();
     }
 
-    QString lastCollection = d->collections.last();
-    QString collectionIdentifier = d->getCollectionIdentifier(lastCollection);
+    // Only the bind parameters change between executions
+    QJsonObject jsonObj = d->preparedJson;
 
-    // Only if limit is over 0, a limit is set
-    if ( d->limit < 1 ) {
-        query = query.arg(collectionIdentifier, lastCollection, QStringLiteral(""), d->where);
+    if ( !d->bindVars.isEmpty() ) {
+        jsonObj.insert(QStringLiteral("bindVars"), QJsonObject::fromVariantMap(d->bindVars));
     }
-    else {
-        QString limit = QStringLiteral("LIMIT %1").arg(QString::number(d->limit));
-        query = query.arg(collectionIdentifier, lastCollection, limit, d->where);
+
+    return QJsonDocument(jsonObj).toJson(QJsonDocument::Compact);
+}
+
+QString QBSelectPrivate::buildQuery() const
+{
+    QString query;
+
+    for ( const QString & collectionName : collections ) {
+        query += QStringLiteral("FOR %1 IN %2 ").arg(getCollectionIdentifier(collectionName), collectionName);
     }
 
-    query = query.arg(d->getResult());
+    if ( !where.isEmpty() ) {
+        query += where + QChar(' ');
+    }
 
-    jsonObj.insert(QStringLiteral("query"), query);
-    jsonObj.insert(QStringLiteral("count"), d->isCounting);
-    jsonObj.insert(QStringLiteral("batchSize"), d->batchSize);
+    QString keyField = getCollectionIdentifier(getCollectionName()) + QStringLiteral("._key");
+    if ( !keyFrom.isEmpty() ) {
+        query += QStringLiteral("FILTER %1 >= @keyFrom ").arg(keyField);
+    }
+    if ( !keyTo.isEmpty() ) {
+        query += QStringLiteral("FILTER %1 < @keyTo ").arg(keyField);
+    }
 
-    if (d->bindVars.size() > 0) {
-        QJsonObject bindVarsObj;
-        bindVarsObj.insert(d->whereField, QJsonArray::fromStringList(d->bindVars));
+    const bool isCollecting = this->isCollecting();
+    if ( isCollecting ) {
+        query += buildCollect() + QChar(' ');
+    }
 
-        jsonObj.insert(QStringLiteral("bindVars"), bindVarsObj);
+    if ( !sortFields.isEmpty() ) {
+        QStringList sorts;
+        for ( const SortField & sortField : sortFields ) {
+            QString attribute;
+            // After a collect only the collected names are in scope
+            if ( isCollecting && (collectNames.contains(sortField.field) ||
+                                  aggregateNames.contains(sortField.field) ||
+                                  countInto == sortField.field) ) {
+                attribute = sortField.field;
+            }
+            else {
+                attribute = getCollectionIdentifier(sortField.collection) + QChar('.') + sortField.field;
+            }
+
+            sorts.append(attribute + ((sortField.direction == QBSelect::SortDirection::Ascending) ? QStringLiteral(" ASC")
+                                                                                                 : QStringLiteral(" DESC")));
+        }
+
+        query += QStringLiteral("SORT ") + sorts.join(QStringLiteral(", ")) + QChar(' ');
+    }
+
+    // Only if limit is over 0, a limit is set. The numbers are bound,
+    // so paging through the results keeps the same query text
+    if ( limit > 0 ) {
+        query += QStringLiteral("LIMIT @limitOffset, @limitCount ");
     }
 
-    jsonDoc.setObject(jsonObj);
-    return jsonDoc.toJson();
+    query += QStringLiteral("RETURN ") + (isCollecting ? getCollectResult() : getResult());
+
+    return query;
 }
 
 }
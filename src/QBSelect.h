@@ -26,6 +26,8 @@
 
 #include "arangodb-driver_global.h"
 #include <QStringList>
+#include <QtCore/QHash>
+#include <QtCore/QVariant>
 
 namespace arangodb
 {
@@ -42,6 +44,47 @@ class QBSelectPrivate;
 class ARANGODBDRIVERSHARED_EXPORT QBSelect
 {
     public:
+        /**
+         * @brief Comparison operators of where conditions
+         *
+         * @since 0.6
+         */
+        enum class Operator : quint8 {
+            Equal           = 0,
+            NotEqual        = 1,
+            Less            = 2,
+            LessEqual       = 3,
+            Greater         = 4,
+            GreaterEqual    = 5,
+            In              = 6,
+            NotIn           = 7,
+            Like            = 8
+        };
+
+        /**
+         * @brief The SortDirection enum
+         *
+         * @since 0.6
+         */
+        enum class SortDirection : quint8 {
+            Ascending   = 0,
+            Descending  = 1
+        };
+
+        /**
+         * @brief The AggregateFunction enum
+         *
+         * @since 0.6
+         */
+        enum class AggregateFunction : quint8 {
+            Count           = 0,
+            Sum             = 1,
+            Min             = 2,
+            Max             = 3,
+            Average         = 4,
+            CountDistinct   = 5
+        };
+
         /**
          * @brief QBSelect
          *
@@ -95,6 +138,26 @@ class ARANGODBDRIVERSHARED_EXPORT QBSelect
          */
         int batchSize() const;
 
+        /**
+         * @brief Sets the time to live in seconds of the cursor
+         * on the server. If it is not used for this time, the
+         * server releases it. A value below 1 keeps the server default.
+         *
+         * @param seconds
+         *
+         * @since 0.6
+         */
+        void setTtl(int seconds);
+
+        /**
+         * @brief ttl
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        int ttl() const;
+
         /**
          * @brief setCounting
          *
@@ -118,7 +181,8 @@ class ARANGODBDRIVERSHARED_EXPORT QBSelect
         /**
          * @brief This method assumes that only one collection
          * is set for the select and therefor the where statement
-         * is set for this collection (first collection in the list)
+         * is set for this collection (first collection in the list).
+         * It replaces all previous conditions.
          *
          * @param field
          * @param op
@@ -131,7 +195,8 @@ class ARANGODBDRIVERSHARED_EXPORT QBSelect
         /**
          * @brief This method assumes that only one collection
          * is set for the select and therefor the where statement
-         * is set for this collection (first collection in the list)
+         * is set for this collection (first collection in the list).
+         * It replaces all previous conditions.
          *
          * @param field
          * @param op
@@ -168,6 +233,153 @@ class ARANGODBDRIVERSHARED_EXPORT QBSelect
         void setWhere(const QString & collection1, const QString & field1,
                       const QString & collection2, const QString & field2);
 
+        /**
+         * @brief Adds a condition on a field of the first collection
+         * which has to be true together with the conditions added
+         * before it. The value is sent as bind parameter.
+         *
+         * @param field
+         * @param op
+         * @param value
+         *
+         * @since 0.6
+         */
+        void andWhere(const QString & field, Operator op, const QVariant & value);
+
+        /**
+         * @brief Adds a condition on a field of the given collection
+         * which has to be true together with the conditions added
+         * before it. The value is sent as bind parameter.
+         *
+         * @param collection
+         * @param field
+         * @param op
+         * @param value
+         *
+         * @since 0.6
+         */
+        void andWhere(const QString & collection, const QString & field, Operator op, const QVariant & value);
+
+        /**
+         * @brief Starts a new group of conditions on a field of the
+         * first collection. A document matches if all conditions of
+         * at least one group are true, so AND binds stronger than OR.
+         *
+         * @param field
+         * @param op
+         * @param value
+         *
+         * @since 0.6
+         */
+        void orWhere(const QString & field, Operator op, const QVariant & value);
+
+        /**
+         * @brief Starts a new group of conditions on a field of the
+         * given collection. A document matches if all conditions of
+         * at least one group are true, so AND binds stronger than OR.
+         *
+         * @param collection
+         * @param field
+         * @param op
+         * @param value
+         *
+         * @since 0.6
+         */
+        void orWhere(const QString & collection, const QString & field, Operator op, const QVariant & value);
+
+        /**
+         * @brief Adds an AQL expression as condition which has to be
+         * true together with the conditions added before it. The
+         * expression can use parameters set with setBindVar as @name
+         * and reach the documents through documentVariable().
+         *
+         * @param expression
+         *
+         * @since 0.6
+         */
+        void andWhereExpression(const QString & expression);
+
+        /**
+         * @brief Starts a new group of conditions with an AQL
+         * expression, see andWhereExpression
+         *
+         * @param expression
+         *
+         * @since 0.6
+         */
+        void orWhereExpression(const QString & expression);
+
+        /**
+         * @brief Returns the AQL variable the documents of the
+         * collection are bound to, the first collection if none
+         * is given
+         *
+         * @param collection
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        QString documentVariable(const QString & collection = QString()) const;
+
+        /**
+         * @brief Removes all where conditions
+         *
+         * @since 0.6
+         */
+        void clearWhere();
+
+        /**
+         * @brief Sets a bind parameter which can be used as @name
+         * in where expressions (see andWhereExpression). The server
+         * rejects queries with parameters they do not use. The names
+         * value0, value1, ..., keyFrom, keyTo, limitOffset and
+         * limitCount are reserved for the parameters of the select
+         * itself and are rejected.
+         *
+         * @param name
+         * @param value
+         *
+         * @return false if the name is reserved
+         *
+         * @since 0.6
+         */
+        bool setBindVar(const QString & name, const QVariant & value);
+
+        /**
+         * @brief Returns true if the name is used for a
+         * bind parameter of the select itself
+         *
+         * @param name
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        static bool isReservedBindVar(const QString & name);
+
+        /**
+         * @brief Returns all bind parameters including the
+         * ones of the where conditions
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        QVariantMap bindVars() const;
+
+        /**
+         * @brief Restricts the select to documents of the first
+         * collection whose key is in the range [from, to). Keys
+         * are compared as strings, an empty bound is unbounded.
+         *
+         * @param from
+         * @param to
+         *
+         * @since 0.6
+         */
+        void setKeyRange(const QString & from, const QString & to);
+
         /**
          * @brief setResult
          *
@@ -200,6 +412,269 @@ class ARANGODBDRIVERSHARED_EXPORT QBSelect
          */
         void setResult(const QHash<QString, QVariant> & collectionFields);
 
+        /**
+         * @brief Limits the result to count documents,
+         * a count below 1 removes the limit
+         *
+         * @param count
+         *
+         * @since 0.6
+         */
+        void setLimit(int count);
+
+        /**
+         * @brief Skips the first offset documents and limits the
+         * result to count documents, a count below 1 removes the limit.
+         * Both numbers are bind parameters, so paging through a result
+         * keeps the prepared query.
+         *
+         * @param offset
+         * @param count
+         *
+         * @since 0.6
+         */
+        void setLimit(int offset, int count);
+
+        /**
+         * @brief limit
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        int limit() const;
+
+        /**
+         * @brief offset
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        int offset() const;
+
+        /**
+         * @brief Sorts the result by a field of the first
+         * collection and replaces all previous sort fields.
+         * While collecting, a grouping, aggregate or count
+         * name can be used as field.
+         *
+         * @param field
+         * @param direction
+         *
+         * @since 0.6
+         */
+        void setSort(const QString & field, SortDirection direction = SortDirection::Ascending);
+
+        /**
+         * @brief Adds a field of the first collection to sort by
+         * when all previous sort fields are equal
+         *
+         * @param field
+         * @param direction
+         *
+         * @since 0.6
+         */
+        void addSort(const QString & field, SortDirection direction = SortDirection::Ascending);
+
+        /**
+         * @brief Adds a field of the given collection to sort by
+         * when all previous sort fields are equal
+         *
+         * @param collection
+         * @param field
+         * @param direction
+         *
+         * @since 0.6
+         */
+        void addSort(const QString & collection, const QString & field,
+                     SortDirection direction = SortDirection::Ascending);
+
+        /**
+         * @brief clearSort
+         *
+         * @since 0.6
+         */
+        void clearSort();
+
+        /**
+         * @brief Groups the documents by a field of the first collection
+         * and replaces all previous groups. The group value is returned
+         * under name, or under the field name if name is empty.
+         *
+         * While collecting, every result row only contains the grouping,
+         * aggregate and count names, the other result settings are
+         * ignored. With setColumnar() every name becomes a typed column.
+         *
+         * @param field
+         * @param name
+         *
+         * @since 0.6
+         */
+        void setCollect(const QString & field, const QString & name = QString());
+
+        /**
+         * @brief Adds a field of the first collection to group by
+         *
+         * @param field
+         * @param name
+         *
+         * @since 0.6
+         */
+        void addCollect(const QString & field, const QString & name = QString());
+
+        /**
+         * @brief Adds a field of the given collection to group by
+         *
+         * @param collection
+         * @param field
+         * @param name
+         *
+         * @since 0.6
+         */
+        void addCollect(const QString & collection, const QString & field, const QString & name = QString());
+
+        /**
+         * @brief Adds an aggregate over a field of the first collection,
+         * which is calculated per group or for all documents if there
+         * are no groups. Count does not need a field.
+         *
+         * @param name
+         * @param function
+         * @param field
+         *
+         * @since 0.6
+         */
+        void addAggregate(const QString & name, AggregateFunction function, const QString & field = QString());
+
+        /**
+         * @brief Counts the documents per group, or all documents
+         * if there are no groups, into name. An empty name
+         * removes the count.
+         *
+         * @param name
+         *
+         * @since 0.6
+         */
+        void setCountInto(const QString & name);
+
+        /**
+         * @brief Removes all groups, aggregates and the count
+         *
+         * @since 0.6
+         */
+        void clearCollect();
+
+        /**
+         * @brief isCollecting
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        bool isCollecting() const;
+
+        /**
+         * @brief Only returns the given fields of the first
+         * collection, under their own names
+         *
+         * @param fields
+         *
+         * @since 0.6
+         */
+        void setProjection(const QStringList & fields);
+
+        /**
+         * @brief If set, the cursor created for this select
+         * decodes its rows into typed columns instead of
+         * Document objects (see QBCursor::setColumnar)
+         *
+         * @param columnar
+         *
+         * @since 0.6
+         */
+        void setColumnar(bool columnar);
+
+        /**
+         * @brief isColumnar
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        bool isColumnar() const;
+
+        /**
+         * @brief If set, the server profiles the query and the
+         * cursor provides the time of every execution phase
+         * (see QBCursor::profile)
+         *
+         * @param profiling
+         *
+         * @since 0.6
+         */
+        void setProfiling(bool profiling);
+
+        /**
+         * @brief isProfiling
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        bool isProfiling() const;
+
+        /**
+         * @brief If set, the server counts how many documents
+         * would have matched without the limit
+         * (see QBCursor::Statistics::fullCount)
+         *
+         * @param fullCount
+         *
+         * @since 0.6
+         */
+        void setFullCount(bool fullCount);
+
+        /**
+         * @brief isFullCount
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        bool isFullCount() const;
+
+        /**
+         * @brief Returns the AQL text of the select without
+         * the bind parameters
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        QString query() const;
+
+        /**
+         * @brief Builds the query text and its json representation
+         * once. They are reused by every following toJson() call
+         * until the structure of the select changes, so executing
+         * the same select again with other bind values (setWhere
+         * on the same field or setBindVar) only serializes the new
+         * values. toJson() prepares the select if needed.
+         *
+         * @since 0.6
+         */
+        void prepare() const;
+
+        /**
+         * @brief isPrepared
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        bool isPrepared() const;
+
         /**
          * @brief Returns the json representation of the query
          * and all its extra information which will be sent to
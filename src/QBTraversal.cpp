@@ -0,0 +1,259 @@
+/********************************************************************************
+ ** The MIT License (MIT)
+ **
+ ** Copyright (c) 2013 Sascha Ludwig Häusler
+ **
+ ** Permission is hereby granted, free of charge, to any person obtaining a copy of
+ ** this software and associated documentation files (the "Software"), to deal in
+ ** the Software without restriction, including without limitation the rights to
+ ** use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ ** the Software, and to permit persons to whom the Software is furnished to do so,
+ ** subject to the following conditions:
+ **
+ ** The above copyright notice and this permission notice shall be included in all
+ ** copies or substantial portions of the Software.
+ **
+ ** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ ** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ ** FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ ** COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ ** IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ ** CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *********************************************************************************/
+
+#include "QBTraversal.h"
+
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+
+namespace arangodb
+{
+
+class QBTraversalPrivate
+{
+    public:
+        QString startVertex;
+        QString targetVertex;
+        QStringList edgeCollections;
+        int batchSize;
+
+        QBTraversal::Direction direction = QBTraversal::Direction::Outbound;
+        QBTraversal::ResultType resultType = QBTraversal::ResultType::Vertices;
+        int minDepth = 1;
+        int maxDepth = 1;
+        bool isUniqueVertices = false;
+
+        inline QString directionName() const {
+            switch (direction)
+            {
+                case QBTraversal::Direction::Inbound:
+                    return QStringLiteral("INBOUND");
+                case QBTraversal::Direction::Any:
+                    return QStringLiteral("ANY");
+                case QBTraversal::Direction::Outbound:
+                default:
+                    return QStringLiteral("OUTBOUND");
+            }
+        }
+
+        /**
+         * @brief Returns the edge collections as
+         * collection bind parameters
+         *
+         * @return
+         */
+        inline QString edgeCollectionParameters() const {
+            QStringList parameters;
+            const int total = edgeCollections.size();
+            for (int i = 0; i < total; ++i) {
+                parameters.append(QStringLiteral("@@edges%1").arg(i));
+            }
+
+            return parameters.join(QStringLiteral(", "));
+        }
+
+        QString buildQuery() const;
+};
+
+QString QBTraversalPrivate::buildQuery() const
+{
+    if ( !targetVertex.isEmpty() ) {
+        const QString result = (resultType == QBTraversal::ResultType::Edges) ? QStringLiteral("e")
+                                                                              : QStringLiteral("v");
+        return QStringLiteral("FOR v, e IN %1 SHORTEST_PATH @start TO @target %2 RETURN %3")
+                .arg(directionName(), edgeCollectionParameters(), result);
+    }
+
+    QString query = QStringLiteral("FOR v, e, p IN @minDepth..@maxDepth %1 @start %2 ")
+            .arg(directionName(), edgeCollectionParameters());
+
+    if ( isUniqueVertices ) {
+        query += QStringLiteral("OPTIONS {bfs: true, uniqueVertices: \"global\"} ");
+    }
+
+    switch (resultType)
+    {
+        case QBTraversal::ResultType::Edges:
+            query += QStringLiteral("RETURN e");
+            break;
+        case QBTraversal::ResultType::Paths:
+            query += QStringLiteral("RETURN p");
+            break;
+        case QBTraversal::ResultType::Vertices:
+        default:
+            query += QStringLiteral("RETURN v");
+            break;
+    }
+
+    return query;
+}
+
+QBTraversal::QBTraversal(const QString & startVertex, const QString & edgeCollection, int batchSize) :
+    d_ptr(new QBTraversalPrivate)
+{
+    Q_D(QBTraversal);
+    d->startVertex = startVertex;
+    d->edgeCollections.append(edgeCollection);
+    d->batchSize = batchSize;
+}
+
+QBTraversal::~QBTraversal()
+{
+    delete d_ptr;
+}
+
+QString QBTraversal::startVertex() const
+{
+    Q_D(const QBTraversal);
+    return d->startVertex;
+}
+
+void QBTraversal::addEdgeCollection(const QString & edgeCollection)
+{
+    Q_D(QBTraversal);
+    if ( !d->edgeCollections.contains(edgeCollection) ) {
+        d->edgeCollections.append(edgeCollection);
+    }
+}
+
+QStringList QBTraversal::edgeCollections() const
+{
+    Q_D(const QBTraversal);
+    return d->edgeCollections;
+}
+
+void QBTraversal::setDirection(Direction direction)
+{
+    Q_D(QBTraversal);
+    d->direction = direction;
+}
+
+QBTraversal::Direction QBTraversal::direction() const
+{
+    Q_D(const QBTraversal);
+    return d->direction;
+}
+
+void QBTraversal::setDepth(int min, int max)
+{
+    Q_D(QBTraversal);
+    d->minDepth = qMax(min, 0);
+    d->maxDepth = qMax(max, d->minDepth);
+}
+
+int QBTraversal::minDepth() const
+{
+    Q_D(const QBTraversal);
+    return d->minDepth;
+}
+
+int QBTraversal::maxDepth() const
+{
+    Q_D(const QBTraversal);
+    return d->maxDepth;
+}
+
+void QBTraversal::setUniqueVertices(bool unique)
+{
+    Q_D(QBTraversal);
+    d->isUniqueVertices = unique;
+}
+
+bool QBTraversal::isUniqueVertices() const
+{
+    Q_D(const QBTraversal);
+    return d->isUniqueVertices;
+}
+
+void QBTraversal::setShortestPath(const QString & targetVertex)
+{
+    Q_D(QBTraversal);
+    d->targetVertex = targetVertex;
+}
+
+bool QBTraversal::isShortestPath() const
+{
+    Q_D(const QBTraversal);
+    return !d->targetVertex.isEmpty();
+}
+
+void QBTraversal::setResultType(ResultType type)
+{
+    Q_D(QBTraversal);
+    d->resultType = type;
+}
+
+QBTraversal::ResultType QBTraversal::resultType() const
+{
+    Q_D(const QBTraversal);
+    return d->resultType;
+}
+
+int QBTraversal::batchSize() const
+{
+    Q_D(const QBTraversal);
+    return d->batchSize;
+}
+
+QString QBTraversal::query() const
+{
+    Q_D(const QBTraversal);
+    return d->buildQuery();
+}
+
+QVariantMap QBTraversal::bindVars() const
+{
+    Q_D(const QBTraversal);
+
+    QVariantMap vars;
+    vars.insert(QStringLiteral("start"), d->startVertex);
+
+    const int total = d->edgeCollections.size();
+    for (int i = 0; i < total; ++i) {
+        vars.insert(QStringLiteral("@edges%1").arg(i), d->edgeCollections.at(i));
+    }
+
+    if ( d->targetVertex.isEmpty() ) {
+        vars.insert(QStringLiteral("minDepth"), d->minDepth);
+        vars.insert(QStringLiteral("maxDepth"), d->maxDepth);
+    }
+    else {
+        vars.insert(QStringLiteral("target"), d->targetVertex);
+    }
+
+    return vars;
+}
+
+QByteArray QBTraversal::toJson() const
+{
+    Q_D(const QBTraversal);
+
+    QJsonObject jsonObj;
+    jsonObj.insert(QStringLiteral("query"), query());
+    jsonObj.insert(QStringLiteral("batchSize"), d->batchSize);
+    jsonObj.insert(QStringLiteral("bindVars"), QJsonObject::fromVariantMap(bindVars()));
+
+    return QJsonDocument(jsonObj).toJson(QJsonDocument::Compact);
+}
+
+}
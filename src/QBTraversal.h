@@ -0,0 +1,270 @@
+/********************************************************************************
+ ** The MIT License (MIT)
+ **
+ ** Copyright (c) 2013 Sascha Ludwig Häusler
+ **
+ ** Permission is hereby granted, free of charge, to any person obtaining a copy of
+ ** this software and associated documentation files (the "Software"), to deal in
+ ** the Software without restriction, including without limitation the rights to
+ ** use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ ** the Software, and to permit persons to whom the Software is furnished to do so,
+ ** subject to the following conditions:
+ **
+ ** The above copyright notice and this permission notice shall be included in all
+ ** copies or substantial portions of the Software.
+ **
+ ** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ ** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ ** FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ ** COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ ** IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ ** CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *********************************************************************************/
+
+#ifndef QBTRAVERSAL_H
+#define QBTRAVERSAL_H
+
+#include "arangodb-driver_global.h"
+#include <QtCore/QStringList>
+#include <QtCore/QVariant>
+
+namespace arangodb
+{
+
+class QBTraversalPrivate;
+
+/**
+ * @brief A graph traversal from one start vertex over one or
+ * more edge collections. It is executed as a single AQL
+ * traversal on the server and its results are loaded through
+ * a QBCursor like the results of a select
+ * (see Arangodbdriver::executeTraversal).
+ *
+ * @since 0.6
+ */
+class ARANGODBDRIVERSHARED_EXPORT QBTraversal
+{
+    public:
+        /**
+         * @brief The direction in which edges are followed
+         *
+         * @since 0.6
+         */
+        enum class Direction : quint8 {
+            Outbound    = 0,
+            Inbound     = 1,
+            Any         = 2
+        };
+
+        /**
+         * @brief What is returned for every visited vertex
+         *
+         * @since 0.6
+         */
+        enum class ResultType : quint8 {
+            Vertices    = 0,
+            Edges       = 1,
+            Paths       = 2
+        };
+
+        /**
+         * @brief QBTraversal
+         *
+         * @param startVertex       Document id of the start vertex
+         * @param edgeCollection
+         * @param batchSize
+         *
+         * @since 0.6
+         */
+        QBTraversal(const QString & startVertex, const QString & edgeCollection, int batchSize);
+
+        /**
+         * @brief ~QBTraversal
+         *
+         * @since 0.6
+         */
+        virtual ~QBTraversal();
+
+        /**
+         * @brief startVertex
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        QString startVertex() const;
+
+        /**
+         * @brief Follows the edges of another collection as well
+         *
+         * @param edgeCollection
+         *
+         * @since 0.6
+         */
+        void addEdgeCollection(const QString & edgeCollection);
+
+        /**
+         * @brief edgeCollections
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        QStringList edgeCollections() const;
+
+        /**
+         * @brief The default direction is Outbound
+         *
+         * @param direction
+         *
+         * @since 0.6
+         */
+        void setDirection(Direction direction);
+
+        /**
+         * @brief direction
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        Direction direction() const;
+
+        /**
+         * @brief Only returns vertices which are between min and
+         * max edges away from the start vertex. The default of
+         * 1 and 1 returns the direct neighbors.
+         *
+         * @param min
+         * @param max
+         *
+         * @since 0.6
+         */
+        void setDepth(int min, int max);
+
+        /**
+         * @brief minDepth
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        int minDepth() const;
+
+        /**
+         * @brief maxDepth
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        int maxDepth() const;
+
+        /**
+         * @brief If set, every vertex is visited only once and
+         * the graph is walked breadth first, which is the
+         * cheapest way to get a k-hop neighborhood
+         *
+         * @param unique
+         *
+         * @since 0.6
+         */
+        void setUniqueVertices(bool unique);
+
+        /**
+         * @brief isUniqueVertices
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        bool isUniqueVertices() const;
+
+        /**
+         * @brief Turns the traversal into a search for the shortest
+         * path from the start vertex to the target vertex. The
+         * vertices of the path are returned in order, the depth
+         * is not used. An empty target turns it back into a
+         * normal traversal.
+         *
+         * @param targetVertex      Document id of the target vertex
+         *
+         * @since 0.6
+         */
+        void setShortestPath(const QString & targetVertex);
+
+        /**
+         * @brief isShortestPath
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        bool isShortestPath() const;
+
+        /**
+         * @brief The default is Vertices. A shortest path
+         * returns either vertices or edges.
+         *
+         * @param type
+         *
+         * @since 0.6
+         */
+        void setResultType(ResultType type);
+
+        /**
+         * @brief resultType
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        ResultType resultType() const;
+
+        /**
+         * @brief batchSize
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        int batchSize() const;
+
+        /**
+         * @brief Returns the AQL text of the traversal
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        QString query() const;
+
+        /**
+         * @brief Returns the bind parameters of the traversal
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        QVariantMap bindVars() const;
+
+        /**
+         * @brief Returns the json representation of the
+         * traversal which will be sent to the database server
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        QByteArray toJson() const;
+
+    protected:
+        QBTraversalPrivate *d_ptr;
+
+    private:
+        Q_DECLARE_PRIVATE(QBTraversal)
+};
+
+}
+
+#endif // QBTRAVERSAL_H
@@ -42,4 +42,12 @@ QSharedPointer<QBSelect> QueryBuilder::createSelect(QStringList & collections, i
     return select;
 }
 
+QSharedPointer<QBTraversal> QueryBuilder::createTraversal(const QString & startVertex,
+                                                          const QString & edgeCollection,
+                                                          int batchSize)
+{
+    QSharedPointer<QBTraversal> traversal(new QBTraversal(startVertex, edgeCollection, batchSize));
+    return traversal;
+}
+
 }
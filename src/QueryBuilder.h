@@ -26,6 +26,7 @@
 
 #include "arangodb-driver_global.h"
 #include "QBSelect.h"
+#include "QBTraversal.h"
 #include <QtCore/QSharedPointer>
 
 namespace arangodb
@@ -67,6 +68,21 @@ class ARANGODBDRIVERSHARED_EXPORT QueryBuilder
          * @since 0.5
          */
         QSharedPointer<QBSelect> createSelect(QStringList & collections, int batchSize = 15);
+
+        /**
+         * @brief createTraversal
+         *
+         * @param startVertex       Document id of the start vertex
+         * @param edgeCollection
+         * @param batchSize
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        QSharedPointer<QBTraversal> createTraversal(const QString & startVertex,
+                                                    const QString & edgeCollection,
+                                                    int batchSize = 15);
 };
 
 }
@@ -0,0 +1,212 @@
+/********************************************************************************
+ ** The MIT License (MIT)
+ **
+ ** Copyright (c) 2013 Sascha Ludwig Häusler
+ **
+ ** Permission is hereby granted, free of charge, to any person obtaining a copy of
+ ** this software and associated documentation files (the "Software"), to deal in
+ ** the Software without restriction, including without limitation the rights to
+ ** use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ ** the Software, and to permit persons to whom the Software is furnished to do so,
+ ** subject to the following conditions:
+ **
+ ** The above copyright notice and this permission notice shall be included in all
+ ** copies or substantial portions of the Software.
+ **
+ ** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ ** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ ** FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ ** COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ ** IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ ** CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *********************************************************************************/
+
+#include "QueryLog.h"
+
+#include <QtCore/QDebug>
+#include <QtCore/QRegularExpression>
+#include <QtCore/QStringList>
+
+#include <algorithm>
+
+using namespace arangodb;
+
+namespace {
+
+inline bool isIdentifierChar(QChar c)
+{
+    return c.isLetterOrNumber() || c == QLatin1Char('_') || c == QLatin1Char('@') || c == QLatin1Char('$');
+}
+
+}
+
+QueryLog::QueryLog() :
+    m_threshold(-1)
+{
+}
+
+void QueryLog::setThreshold(int milliseconds)
+{
+    m_threshold = milliseconds;
+}
+
+int QueryLog::threshold() const
+{
+    return m_threshold;
+}
+
+void QueryLog::record(const QString & fingerprint, const QVariantMap & bindVars, bool isFirstBatch,
+                      int rows, qint64 bytes, qint64 microseconds)
+{
+    auto it = m_queries.find(fingerprint);
+    if ( it == m_queries.end() && m_queries.size() < MaxFingerprints ) {
+        it = m_queries.insert(fingerprint, QueryStatistics());
+        it.value().fingerprint = fingerprint;
+    }
+
+    if ( it != m_queries.end() ) {
+        QueryStatistics & query = it.value();
+        if ( isFirstBatch ) query.count++;
+        query.batches++;
+        query.rows += rows;
+        query.bytes += bytes;
+        query.latency.record(microseconds);
+    }
+
+    if ( m_threshold >= 0 && microseconds > qint64(m_threshold) * 1000 ) {
+        qWarning().noquote() << QStringLiteral("Slow query (%1): %2 ms, %3 rows, %4 bytes: %5 bind vars %6")
+                                .arg(isFirstBatch ? QStringLiteral("execute") : QStringLiteral("next batch"))
+                                .arg(microseconds / 1000)
+                                .arg(rows)
+                                .arg(bytes)
+                                .arg(fingerprint, bindVarShape(bindVars));
+    }
+}
+
+QList<QueryLog::QueryStatistics> QueryLog::queries() const
+{
+    QList<QueryStatistics> queries = m_queries.values();
+    std::sort(queries.begin(), queries.end(), [](const QueryStatistics & a, const QueryStatistics & b) {
+        return a.latency.sum() > b.latency.sum();
+    });
+    return queries;
+}
+
+QueryLog::QueryStatistics QueryLog::query(const QString & fingerprint) const
+{
+    return m_queries.value(fingerprint);
+}
+
+void QueryLog::clear()
+{
+    m_queries.clear();
+}
+
+QString QueryLog::fingerprint(const QString & query)
+{
+    QString result;
+    result.reserve(query.size());
+
+    const int size = query.size();
+    int i = 0;
+
+    while ( i < size ) {
+        const QChar c = query.at(i);
+
+        // String literals, with escaped quotes
+        if ( c == QLatin1Char('"') || c == QLatin1Char('\'') ) {
+            ++i;
+            while ( i < size && query.at(i) != c ) {
+                if ( query.at(i) == QLatin1Char('\\') ) ++i;
+                ++i;
+            }
+            ++i;
+            result += QLatin1Char('?');
+        }
+        // Quoted names are kept
+        else if ( c == QLatin1Char('`') ) {
+            const int end = query.indexOf(QLatin1Char('`'), i + 1);
+            const int next = (end < 0) ? size : end + 1;
+            result += query.midRef(i, next - i);
+            i = next;
+        }
+        else if ( c == QLatin1Char('/') && i + 1 < size && query.at(i + 1) == QLatin1Char('/') ) {
+            while ( i < size && query.at(i) != QLatin1Char('\n') ) ++i;
+        }
+        else if ( c == QLatin1Char('/') && i + 1 < size && query.at(i + 1) == QLatin1Char('*') ) {
+            const int end = query.indexOf(QStringLiteral("*/"), i + 2);
+            i = (end < 0) ? size : end + 2;
+        }
+        // Numbers, but not the digits of names like v1 or temp2
+        else if ( c.isDigit() && (result.isEmpty() || !isIdentifierChar(result.at(result.size() - 1))) ) {
+            while ( i < size ) {
+                const QChar n = query.at(i);
+                if ( n.isDigit() ) {
+                    ++i;
+                }
+                // A decimal point, not the .. of a range
+                else if ( n == QLatin1Char('.') && i + 1 < size && query.at(i + 1).isDigit() ) {
+                    ++i;
+                }
+                else if ( (n == QLatin1Char('e') || n == QLatin1Char('E')) && i + 1 < size
+                          && (query.at(i + 1).isDigit() || query.at(i + 1) == QLatin1Char('-')
+                              || query.at(i + 1) == QLatin1Char('+')) ) {
+                    i += 2;
+                }
+                else {
+                    break;
+                }
+            }
+            result += QLatin1Char('?');
+        }
+        else if ( c.isSpace() ) {
+            while ( i < size && query.at(i).isSpace() ) ++i;
+            if ( !result.isEmpty() ) result += QLatin1Char(' ');
+        }
+        else {
+            result += c;
+            ++i;
+        }
+    }
+
+    // Lists of literals of any length are the same query
+    static const QRegularExpression list(QStringLiteral("\\[\\s*\\?(\\s*,\\s*\\?)*\\s*\\]"));
+    result.replace(list, QStringLiteral("[?]"));
+
+    return result.trimmed();
+}
+
+QString QueryLog::bindVarShape(const QVariantMap & bindVars)
+{
+    QStringList shape;
+
+    for ( auto it = bindVars.constBegin(); it != bindVars.constEnd(); ++it ) {
+        QString type;
+
+        if ( it.key().startsWith(QLatin1Char('@')) ) {
+            type = QStringLiteral("collection");
+        }
+        else {
+            switch (it.value().type())
+            {
+                case QVariant::Invalid:     type = QStringLiteral("null"); break;
+                case QVariant::Bool:        type = QStringLiteral("bool"); break;
+                case QVariant::Int:
+                case QVariant::UInt:
+                case QVariant::LongLong:
+                case QVariant::ULongLong:
+                case QVariant::Double:      type = QStringLiteral("number"); break;
+                case QVariant::String:      type = QStringLiteral("string"); break;
+                case QVariant::List:
+                case QVariant::StringList:  type = QStringLiteral("array[%1]").arg(it.value().toList().size()); break;
+                case QVariant::Map:
+                case QVariant::Hash:        type = QStringLiteral("object"); break;
+                default:                    type = QString::fromLatin1(it.value().typeName()); break;
+            }
+        }
+
+        shape << it.key() + QStringLiteral(": ") + type;
+    }
+
+    return QStringLiteral("{") + shape.join(QStringLiteral(", ")) + QStringLiteral("}");
+}
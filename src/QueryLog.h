@@ -0,0 +1,198 @@
+/********************************************************************************
+ ** The MIT License (MIT)
+ **
+ ** Copyright (c) 2013 Sascha Ludwig Häusler
+ **
+ ** Permission is hereby granted, free of charge, to any person obtaining a copy of
+ ** this software and associated documentation files (the "Software"), to deal in
+ ** the Software without restriction, including without limitation the rights to
+ ** use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ ** the Software, and to permit persons to whom the Software is furnished to do so,
+ ** subject to the following conditions:
+ **
+ ** The above copyright notice and this permission notice shall be included in all
+ ** copies or substantial portions of the Software.
+ **
+ ** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ ** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ ** FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ ** COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ ** IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ ** CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *********************************************************************************/
+
+#ifndef QUERYLOG_H
+#define QUERYLOG_H
+
+#include "arangodb-driver_global.h"
+#include "DriverStatistics.h"
+
+#include <QtCore/QHash>
+#include <QtCore/QList>
+#include <QtCore/QString>
+#include <QtCore/QVariantMap>
+
+namespace arangodb
+{
+
+/**
+ * @brief Aggregates the round trips of AQL queries by their
+ * fingerprint, the query text with all literals replaced
+ * by ?, and logs every round trip above a threshold with
+ * the fingerprint and the types of its bind vars.
+ *
+ * Used by Arangodbdriver (see Arangodbdriver::queryStatistics).
+ *
+ * @since 0.6
+ */
+class ARANGODBDRIVERSHARED_EXPORT QueryLog
+{
+    public:
+        /**
+         * @brief Round trips of all queries with the same fingerprint
+         *
+         * @since 0.6
+         */
+        struct QueryStatistics {
+                QString fingerprint;
+
+                /**
+                 * @brief number of executed queries
+                 *
+                 * @since 0.6
+                 */
+                qint64 count = 0;
+
+                /**
+                 * @brief number of batches, the first
+                 * batch of every query included
+                 *
+                 * @since 0.6
+                 */
+                qint64 batches = 0;
+
+                qint64 rows = 0;
+                qint64 bytes = 0;
+
+                /**
+                 * @brief time of every batch from sending the
+                 * request until the reply was decoded
+                 *
+                 * @since 0.6
+                 */
+                LatencyHistogram latency;
+        };
+
+        /**
+         * @brief QueryLog
+         *
+         * @since 0.6
+         */
+        QueryLog();
+
+        /**
+         * @brief Sets the time in milliseconds above which a
+         * round trip is logged, a negative value disables
+         * the log, the default is -1
+         *
+         * @param milliseconds
+         *
+         * @since 0.6
+         */
+        void setThreshold(int milliseconds);
+
+        /**
+         * @brief threshold
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        int threshold() const;
+
+        /**
+         * @brief Records the round trip of one batch
+         *
+         * @param fingerprint   see fingerprint()
+         * @param bindVars
+         * @param isFirstBatch  true if the query was executed
+         * @param rows
+         * @param bytes
+         * @param microseconds
+         *
+         * @since 0.6
+         */
+        void record(const QString & fingerprint, const QVariantMap & bindVars, bool isFirstBatch,
+                    int rows, qint64 bytes, qint64 microseconds);
+
+        /**
+         * @brief Returns the statistics of all fingerprints, the
+         * one with the highest total time first
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        QList<QueryStatistics> queries() const;
+
+        /**
+         * @brief Returns the statistics of one fingerprint
+         *
+         * @param fingerprint
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        QueryStatistics query(const QString & fingerprint) const;
+
+        /**
+         * @brief Removes all statistics
+         *
+         * @since 0.6
+         */
+        void clear();
+
+        /**
+         * @brief Returns the query with all string and number
+         * literals replaced by ? and the whitespace collapsed,
+         * so all queries which only differ in their literals
+         * have the same fingerprint
+         *
+         * @param query
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        static QString fingerprint(const QString & query);
+
+        /**
+         * @brief Returns the names and types of the bind vars
+         * without their values, e.g. {@@coll: collection, limit: number}
+         *
+         * @param bindVars
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        static QString bindVarShape(const QVariantMap & bindVars);
+
+        /**
+         * @brief Fingerprints above this number are not aggregated
+         * anymore, so generated queries with inlined values
+         * can not use up the memory
+         *
+         * @since 0.6
+         */
+        static const int MaxFingerprints = 1000;
+
+    private:
+        QHash<QString, QueryStatistics> m_queries;
+        int m_threshold;
+};
+
+}
+
+#endif // QUERYLOG_H
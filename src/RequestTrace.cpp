@@ -0,0 +1,137 @@
+/********************************************************************************
+ ** The MIT License (MIT)
+ **
+ ** Copyright (c) 2013 Sascha Ludwig Häusler
+ **
+ ** Permission is hereby granted, free of charge, to any person obtaining a copy of
+ ** this software and associated documentation files (the "Software"), to deal in
+ ** the Software without restriction, including without limitation the rights to
+ ** use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ ** the Software, and to permit persons to whom the Software is furnished to do so,
+ ** subject to the following conditions:
+ **
+ ** The above copyright notice and this permission notice shall be included in all
+ ** copies or substantial portions of the Software.
+ **
+ ** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ ** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ ** FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ ** COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ ** IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ ** CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *********************************************************************************/
+
+#include "RequestTrace.h"
+
+#include <QtCore/QFile>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+
+#include <algorithm>
+
+using namespace arangodb;
+
+namespace {
+
+QJsonObject completeEvent(const QString & name, const QString & category,
+                          qint64 start, qint64 duration, int row)
+{
+    QJsonObject event;
+    event.insert(QStringLiteral("name"), name);
+    event.insert(QStringLiteral("cat"), category);
+    event.insert(QStringLiteral("ph"), QStringLiteral("X"));
+    event.insert(QStringLiteral("ts"), start);
+    event.insert(QStringLiteral("dur"), duration);
+    event.insert(QStringLiteral("pid"), 1);
+    event.insert(QStringLiteral("tid"), row);
+    return event;
+}
+
+}
+
+qint64 RequestTrace::duration() const
+{
+    return qMax(qMax(qMax(encrypted, sent), qMax(firstByte, transferred)), qMax(decoded, qint64(0)));
+}
+
+void TraceEventWriter::append(const RequestTrace & trace)
+{
+    m_traces << trace;
+}
+
+int TraceEventWriter::size() const
+{
+    return m_traces.size();
+}
+
+void TraceEventWriter::clear()
+{
+    m_traces.clear();
+}
+
+QByteArray TraceEventWriter::toJson() const
+{
+    // Requests are appended when they are finished,
+    // rows are assigned in the order they started
+    QList<RequestTrace> traces = m_traces;
+    std::stable_sort(traces.begin(), traces.end(), [](const RequestTrace & a, const RequestTrace & b) {
+        return a.started < b.started;
+    });
+
+    const QPair<qint64 RequestTrace::*, QString> phases[] = {
+        { &RequestTrace::encrypted,     QStringLiteral("connect") },
+        { &RequestTrace::sent,          QStringLiteral("send") },
+        { &RequestTrace::firstByte,     QStringLiteral("wait") },
+        { &RequestTrace::transferred,   QStringLiteral("transfer") },
+        { &RequestTrace::decoded,       QStringLiteral("decode") }
+    };
+
+    QVector<qint64> rowEnds;
+    QJsonArray events;
+
+    for ( const RequestTrace & trace : traces ) {
+        const qint64 duration = trace.duration();
+
+        int row = 0;
+        while ( row < rowEnds.size() && rowEnds.at(row) > trace.started ) ++row;
+        if ( row == rowEnds.size() ) rowEnds << 0;
+        rowEnds[row] = trace.started + duration;
+
+        QJsonObject request = completeEvent(DriverStatistics::operationName(trace.operation),
+                                            QStringLiteral("request"), trace.started, duration, row);
+        QJsonObject args;
+        args.insert(QStringLiteral("id"), qint64(trace.id));
+        args.insert(QStringLiteral("url"), trace.url);
+        args.insert(QStringLiteral("status"), trace.statusCode);
+        args.insert(QStringLiteral("bytesSent"), trace.bytesSent);
+        args.insert(QStringLiteral("bytesReceived"), trace.bytesReceived);
+        request.insert(QStringLiteral("args"), args);
+        events.append(request);
+
+        qint64 phaseStart = 0;
+        for ( const auto & phase : phases ) {
+            const qint64 mark = trace.*(phase.first);
+            if ( mark < phaseStart ) continue;
+
+            events.append(completeEvent(phase.second, QStringLiteral("phase"),
+                                        trace.started + phaseStart, mark - phaseStart, row));
+            phaseStart = mark;
+        }
+    }
+
+    QJsonObject root;
+    root.insert(QStringLiteral("traceEvents"), events);
+    root.insert(QStringLiteral("displayTimeUnit"), QStringLiteral("ms"));
+    return QJsonDocument(root).toJson(QJsonDocument::Compact);
+}
+
+bool TraceEventWriter::save(const QString & fileName) const
+{
+    QFile file(fileName);
+    if ( !file.open(QIODevice::WriteOnly | QIODevice::Truncate) ) {
+        return false;
+    }
+
+    return file.write(toJson()) >= 0;
+}
@@ -0,0 +1,163 @@
+/********************************************************************************
+ ** The MIT License (MIT)
+ **
+ ** Copyright (c) 2013 Sascha Ludwig Häusler
+ **
+ ** Permission is hereby granted, free of charge, to any person obtaining a copy of
+ ** this software and associated documentation files (the "Software"), to deal in
+ ** the Software without restriction, including without limitation the rights to
+ ** use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ ** the Software, and to permit persons to whom the Software is furnished to do so,
+ ** subject to the following conditions:
+ **
+ ** The above copyright notice and this permission notice shall be included in all
+ ** copies or substantial portions of the Software.
+ **
+ ** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ ** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ ** FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ ** COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ ** IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ ** CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *********************************************************************************/
+
+#ifndef REQUESTTRACE_H
+#define REQUESTTRACE_H
+
+#include "arangodb-driver_global.h"
+#include "DriverStatistics.h"
+
+#include <QtCore/QByteArray>
+#include <QtCore/QList>
+#include <QtCore/QString>
+#include <QtCore/QVector>
+
+namespace arangodb
+{
+
+/**
+ * @brief Timestamps of the phases of one request
+ * (see Arangodbdriver::setTraceCallback)
+ *
+ * All phase marks are microseconds after started and
+ * -1 if the request never reached the phase. A phase
+ * lasts from the previous reached mark until its own:
+ *
+ * - encrypted: queueing, connecting and the TLS handshake
+ * - sent: the request body was written to the socket
+ * - firstByte: the server answered with the headers
+ * - transferred: the whole body was received
+ * - decoded: the consumer (Document, QBCursor, ...) parsed the body,
+ *   QBCursor only handed big batches to its thread pool by then
+ *
+ * Without TLS queueing and connecting are part of the
+ * first phase that was reached.
+ *
+ * @since 0.6
+ */
+struct ARANGODBDRIVERSHARED_EXPORT RequestTrace {
+        quint64 id = 0;
+        DriverStatistics::Operation operation = DriverStatistics::Operation::DocumentGet;
+        QString url;
+        int statusCode = 0;
+        qint64 bytesSent = 0;
+        qint64 bytesReceived = 0;
+
+        /**
+         * @brief microseconds on the trace clock of the driver
+         * when the request was handed to the network manager
+         *
+         * @since 0.6
+         */
+        qint64 started = 0;
+
+        qint64 encrypted = -1;
+        qint64 sent = -1;
+        qint64 firstByte = -1;
+        qint64 transferred = -1;
+        qint64 decoded = -1;
+
+        /**
+         * @brief Returns the time from started until the last reached phase
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        qint64 duration() const;
+};
+
+/**
+ * @brief Collects RequestTrace's and writes them in the Chrome
+ * trace event format, which can be opened as a timeline in
+ * chrome://tracing or Perfetto.
+ *
+ * Every request becomes one event with its phases nested
+ * below, overlapping requests are spread over several rows.
+ *
+ * @code
+ * TraceEventWriter writer;
+ * driver.setTraceCallback([&writer](const RequestTrace & trace) {
+ *     writer.append(trace);
+ * });
+ * ...
+ * writer.save("requests.json");
+ * @endcode
+ *
+ * @since 0.6
+ */
+class ARANGODBDRIVERSHARED_EXPORT TraceEventWriter
+{
+    public:
+        /**
+         * @brief append
+         *
+         * @param trace
+         *
+         * @since 0.6
+         */
+        void append(const RequestTrace & trace);
+
+        /**
+         * @brief Returns the number of appended requests
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        int size() const;
+
+        /**
+         * @brief Removes all appended requests
+         *
+         * @since 0.6
+         */
+        void clear();
+
+        /**
+         * @brief Returns the trace as JSON object with traceEvents array
+         *
+         * @return
+         *
+         * @since 0.6
+         */
+        QByteArray toJson() const;
+
+        /**
+         * @brief Writes the trace into a file
+         *
+         * @param fileName
+         *
+         * @return false if the file couldn't be written
+         *
+         * @since 0.6
+         */
+        bool save(const QString & fileName) const;
+
+    private:
+        QList<RequestTrace> m_traces;
+};
+
+}
+
+#endif // REQUESTTRACE_H
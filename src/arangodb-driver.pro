@@ -35,7 +35,21 @@ SOURCES += Arangodbdriver.cpp \
     Edge.cpp \
     QueryBuilder.cpp \
     QBSelect.cpp \
-    QBCursor.cpp
+    QBCursor.cpp \
+    QBColumn.cpp \
+    QBParallelScan.cpp \
+    QBExplain.cpp \
+    QBTraversal.cpp \
+    EdgeImport.cpp \
+    AdjacencyCache.cpp \
+    DriverStatistics.cpp \
+    RequestTrace.cpp \
+    MetricsExporter.cpp \
+    QueryLog.cpp \
+    MemoryUsage.cpp \
+    CallbackExecutor.cpp \
+    AsyncDriver.cpp \
+    JsonDecoder.cpp
 
 HEADERS += Arangodbdriver.h\
         arangodb-driver_global.h \
@@ -45,4 +59,20 @@ HEADERS += Arangodbdriver.h\
     private/Document_p.h \
     QueryBuilder.h \
     QBSelect.h \
-    QBCursor.h
+    QBCursor.h \
+    QBColumn.h \
+    QBParallelScan.h \
+    QBExplain.h \
+    QBTraversal.h \
+    EdgeImport.h \
+    AdjacencyCache.h \
+    DriverStatistics.h \
+    RequestTrace.h \
+    MetricsExporter.h \
+    QueryLog.h \
+    MemoryUsage.h \
+    private/MemoryAccounting_p.h \
+    CallbackExecutor.h \
+    AsyncDriver.h \
+    private/MpscQueue_p.h \
+    private/JsonDecoder_p.h
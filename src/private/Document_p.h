@@ -24,12 +24,20 @@
 #ifndef DOCUMENT_P_H
 #define DOCUMENT_P_H
 
+#include "MemoryAccounting_p.h"
+
 #include <QtCore/QJsonDocument>
 #include <QtCore/QJsonObject>
 #include <QtNetwork/QNetworkReply>
 
 namespace internal {
 
+const QString ID  = QStringLiteral("_id");
+const QString KEY = QStringLiteral("_key");
+const QString REV = QStringLiteral("_rev");
+const QString FROM  = QStringLiteral("_from");
+const QString TO = QStringLiteral("_to");
+
 class DocumentPrivate
 {
     public:
@@ -46,16 +54,100 @@ class DocumentPrivate
 
         QStringList dirtyAttributes;
 
+        /**
+         * @brief bytes of data counted in MemoryAccounting
+         */
+        qint64 accountedBytes = 0;
+
+        DocumentPrivate() {
+            MemoryAccounting::documentCount.fetchAndAddRelaxed(1);
+            MemoryAccounting::documentBytes.fetchAndAddRelaxed(sizeof(DocumentPrivate) + MemoryAccounting::ObjectOverhead);
+        }
+
+        ~DocumentPrivate() {
+            MemoryAccounting::documentCount.fetchAndAddRelaxed(-1);
+            MemoryAccounting::documentBytes.fetchAndAddRelaxed(-qint64(sizeof(DocumentPrivate) + MemoryAccounting::ObjectOverhead)
+                                                               - accountedBytes);
+        }
+
+        /**
+         * @brief Stops counting the data, called before it is
+         * replaced by storage which is counted elsewhere
+         *
+         * @since 0.6
+         */
+        inline void releaseAccounting() {
+            MemoryAccounting::documentBytes.fetchAndAddRelaxed(-accountedBytes);
+            accountedBytes = 0;
+        }
+
+        /**
+         * @brief Inserts the attribute and counts the difference
+         * to the value it replaces. The estimate walks the values,
+         * so it is only made while a soft limit is set.
+         *
+         * @param key
+         * @param value
+         *
+         * @since 0.6
+         */
+        inline void insert(const QString & key, const QJsonValue & value) {
+            if ( !MemoryAccounting::isEstimatingDocuments() ) {
+                data.insert(key, value);
+                return;
+            }
+
+            qint64 bytes = MemoryAccounting::estimate(key) + MemoryAccounting::estimate(value);
+
+            QJsonObject::const_iterator existing = data.constFind(key);
+            if ( existing != data.constEnd() ) {
+                bytes -= MemoryAccounting::estimate(key) + MemoryAccounting::estimate(existing.value());
+            }
+
+            data.insert(key, value);
+            MemoryAccounting::documentBytes.fetchAndAddRelaxed(bytes);
+            accountedBytes += bytes;
+        }
+
         inline void resetError() {
             errorMessage.clear();
             errorCode = 0;
             errorNumber = 0;
         }
-};
 
-const QString ID  = QStringLiteral("_id");
-const QString KEY = QStringLiteral("_key");
-const QString REV = QStringLiteral("_rev");
+        /**
+         * @brief Takes over one row of a cursor result. As long as
+         * the row is not modified it shares the storage of the batch
+         * it was parsed from, so a whole batch is allocated once and
+         * released in one step when its last row is dropped.
+         * The cursor counts the batch, so the row is not estimated.
+         * The state a recycled document got from save() or
+         * updateStatus() is reset as well.
+         *
+         * @param obj
+         *
+         * @since 0.6
+         */
+        inline void setCursorResult(const QJsonObject & obj) {
+            dirtyAttributes.clear();
+            isReady = false;
+            isCreated = false;
+            isDirty = false;
+            resetError();
+
+            releaseAccounting();
+            data = obj;
+
+            if ( obj.contains(ID) ) {
+                collectionName = obj.value(ID).toString().split('/').at(0);
+                isCurrent = false;
+            }
+            else {
+                collectionName.clear();
+                isCurrent = true;
+            }
+        }
+};
 
 }
 
@@ -0,0 +1,100 @@
+/********************************************************************************
+ ** The MIT License (MIT)
+ **
+ ** Copyright (c) 2013 Sascha Ludwig Häusler
+ **
+ ** Permission is hereby granted, free of charge, to any person obtaining a copy of
+ ** this software and associated documentation files (the "Software"), to deal in
+ ** the Software without restriction, including without limitation the rights to
+ ** use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ ** the Software, and to permit persons to whom the Software is furnished to do so,
+ ** subject to the following conditions:
+ **
+ ** The above copyright notice and this permission notice shall be included in all
+ ** copies or substantial portions of the Software.
+ **
+ ** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ ** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ ** FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ ** COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ ** IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ ** CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *********************************************************************************/
+
+#ifndef JSONDECODER_P_H
+#define JSONDECODER_P_H
+
+#include <QtCore/QByteArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QObject>
+
+#include <functional>
+#include <memory>
+
+class QThreadPool;
+
+namespace internal {
+
+class JsonDecodeTask;
+
+/**
+ * @brief Parses a reply body on a thread pool and calls the
+ * callback with the document in the thread of the context.
+ * The decoder is a child of the context, so the callback
+ * is dropped together with the context.
+ *
+ * @since 0.6
+ */
+class JsonDecoder : public QObject
+{
+    public:
+        /**
+         * @brief JsonDecoder
+         *
+         * @param context
+         * @param callback
+         *
+         * @since 0.6
+         */
+        JsonDecoder(QObject * context, std::function<void(const QJsonDocument &)> callback);
+
+        /**
+         * @brief Stops the delivery of a running decode
+         *
+         * @since 0.6
+         */
+        virtual ~JsonDecoder();
+
+        /**
+         * @brief Hands the data to the pool, the decoder
+         * deletes itself after the callback
+         *
+         * @param pool
+         * @param data
+         *
+         * @since 0.6
+         */
+        void start(QThreadPool * pool, const QByteArray & data);
+
+        /**
+         * @brief Replaces the callback of a running decode
+         *
+         * @param callback
+         *
+         * @since 0.6
+         */
+        inline void setCallback(std::function<void(const QJsonDocument &)> callback) {
+            m_callback = std::move(callback);
+        }
+
+    protected:
+        bool event(QEvent * event) override;
+
+    private:
+        std::shared_ptr<JsonDecodeTask> m_task;
+        std::function<void(const QJsonDocument &)> m_callback;
+};
+
+}
+
+#endif // JSONDECODER_P_H
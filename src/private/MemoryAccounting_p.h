@@ -0,0 +1,101 @@
+/********************************************************************************
+ ** The MIT License (MIT)
+ **
+ ** Copyright (c) 2013 Sascha Ludwig Häusler
+ **
+ ** Permission is hereby granted, free of charge, to any person obtaining a copy of
+ ** this software and associated documentation files (the "Software"), to deal in
+ ** the Software without restriction, including without limitation the rights to
+ ** use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ ** the Software, and to permit persons to whom the Software is furnished to do so,
+ ** subject to the following conditions:
+ **
+ ** The above copyright notice and this permission notice shall be included in all
+ ** copies or substantial portions of the Software.
+ **
+ ** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ ** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ ** FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ ** COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ ** IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ ** CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *********************************************************************************/
+
+#ifndef MEMORYACCOUNTING_P_H
+#define MEMORYACCOUNTING_P_H
+
+#include <QtCore/QAtomicInteger>
+#include <QtCore/QAtomicInt>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonObject>
+#include <QtCore/QJsonValue>
+
+namespace internal {
+
+/**
+ * @brief Process wide gauges of the memory held by documents
+ * and cursors, which can be used from any thread
+ *
+ * @since 0.6
+ */
+class MemoryAccounting
+{
+    public:
+        static QAtomicInteger<qint64> documentBytes;
+        static QAtomicInteger<qint64> documentCount;
+        static QAtomicInteger<qint64> cursorBytes;
+
+        /**
+         * @brief Number of drivers with a soft limit. Attributes set
+         * on documents are only estimated while there is one.
+         */
+        static QAtomicInt softLimits;
+
+        static inline bool isEstimatingDocuments() {
+            return softLimits.load() > 0;
+        }
+
+        /**
+         * @brief QObject with its private data
+         */
+        static const int ObjectOverhead = 160;
+
+        /**
+         * @brief Header of a value in the JSON storage
+         */
+        static const int ValueOverhead = 16;
+
+        static inline qint64 estimate(const QString & string) {
+            return ValueOverhead + string.size() * qint64(sizeof(QChar));
+        }
+
+        static inline qint64 estimate(const QJsonObject & object) {
+            qint64 bytes = ValueOverhead;
+            for ( auto it = object.constBegin(); it != object.constEnd(); ++it ) {
+                bytes += estimate(it.key()) + estimate(it.value());
+            }
+            return bytes;
+        }
+
+        static inline qint64 estimate(const QJsonArray & array) {
+            qint64 bytes = ValueOverhead;
+            for ( const QJsonValue & value : array ) {
+                bytes += estimate(value);
+            }
+            return bytes;
+        }
+
+        static inline qint64 estimate(const QJsonValue & value) {
+            switch (value.type())
+            {
+                case QJsonValue::String:    return estimate(value.toString());
+                case QJsonValue::Array:     return estimate(value.toArray());
+                case QJsonValue::Object:    return estimate(value.toObject());
+                default:                    return ValueOverhead;
+            }
+        }
+};
+
+}
+
+#endif // MEMORYACCOUNTING_P_H
@@ -0,0 +1,117 @@
+/********************************************************************************
+ ** The MIT License (MIT)
+ **
+ ** Copyright (c) 2013 Sascha Ludwig Häusler
+ **
+ ** Permission is hereby granted, free of charge, to any person obtaining a copy of
+ ** this software and associated documentation files (the "Software"), to deal in
+ ** the Software without restriction, including without limitation the rights to
+ ** use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ ** the Software, and to permit persons to whom the Software is furnished to do so,
+ ** subject to the following conditions:
+ **
+ ** The above copyright notice and this permission notice shall be included in all
+ ** copies or substantial portions of the Software.
+ **
+ ** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ ** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ ** FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ ** COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ ** IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ ** CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *********************************************************************************/
+
+#ifndef MPSCQUEUE_P_H
+#define MPSCQUEUE_P_H
+
+#include <QtCore/QAtomicPointer>
+
+#include <utility>
+
+namespace internal {
+
+/**
+ * @brief Unbounded lock-free queue for many producers and a
+ * single consumer (Dmitry Vyukov's node based queue). Pushing
+ * is one atomic exchange and never waits for other producers
+ * or the consumer.
+ *
+ * While a producer is between its exchange and linking its
+ * node, pop can return false although later values were
+ * already pushed, they become visible as soon as the link
+ * is stored. The producer has to wake up the consumer
+ * after push returned.
+ *
+ * @since 0.6
+ */
+template<typename T>
+class MpscQueue
+{
+    public:
+        MpscQueue() :
+            m_head(new Node),
+            m_tail(m_head.load())
+        {
+        }
+
+        ~MpscQueue() {
+            T value;
+            while ( pop(&value) ) {}
+            delete m_tail;
+        }
+
+        /**
+         * @brief Can be called from any thread
+         *
+         * @param value
+         *
+         * @since 0.6
+         */
+        void push(T value) {
+            Node * node = new Node;
+            node->value = std::move(value);
+
+            Node * previous = m_head.fetchAndStoreOrdered(node);
+            previous->next.storeRelease(node);
+        }
+
+        /**
+         * @brief Must only be called by the consumer thread
+         *
+         * @param value
+         *
+         * @return false if the queue is empty
+         *
+         * @since 0.6
+         */
+        bool pop(T * value) {
+            Node * tail = m_tail;
+            Node * next = tail->next.loadAcquire();
+            if ( next == nullptr ) {
+                return false;
+            }
+
+            // next becomes the new empty stub node
+            *value = std::move(next->value);
+            next->value = T();
+            m_tail = next;
+            delete tail;
+
+            return true;
+        }
+
+    private:
+        struct Node {
+            QAtomicPointer<Node> next;
+            T value;
+        };
+
+        QAtomicPointer<Node> m_head;
+        Node * m_tail;
+
+        Q_DISABLE_COPY(MpscQueue)
+};
+
+}
+
+#endif // MPSCQUEUE_P_H
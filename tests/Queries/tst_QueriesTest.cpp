@@ -23,9 +23,12 @@
 
 #include <QString>
 #include <QtTest>
+#include <QtNetwork/QTcpSocket>
 #include <Arangodbdriver.h>
 #include <QueryBuilder.h>
 #include <QBSelect.h>
+#include <MetricsExporter.h>
+#include <AsyncDriver.h>
 
 class QueriesTest : public QObject
 {
@@ -42,9 +45,32 @@ class QueriesTest : public QObject
         void testGetAllDocuments();
         void testLoadMoreResults();
         void testGetDocByWhere();
+        void testCursorRowsKeepAttributes();
         void testGetMultipleDocsByWhere();
         void testGetAllDocumentsFromTwoCollections();
         void testSetResultWithMultipleCollections();
+        void testColumnarResult();
+        void testColumnOutOfRangeNumbers();
+        void testDisposeCursor();
+        void testDisposePendingCursor();
+        void testParallelScan();
+        void testExportAll();
+        void testWhereUsesBindVars();
+        void testReservedBindVars();
+        void testWhereExpression();
+        void testComposedWhere();
+        void testSortLimitProjection();
+        void testCollectAggregate();
+        void testExplainAndStatistics();
+        void testCursorTotalCount();
+        void testTraversalQuery();
+        void testRequestStatistics();
+        void testRequestTrace();
+        void testMetricsExporter();
+        void testQueryFingerprint();
+        void testMemoryUsage();
+        void testAsyncDriver();
+        void testBackgroundDecode();
 
     private:
         arangodb::Arangodbdriver driver;
@@ -164,6 +190,25 @@ void QueriesTest::testGetDocByWhere()
     QCOMPARE(cursor->count(), 2);
 }
 
+void QueriesTest::testCursorRowsKeepAttributes()
+{
+    auto select = qb.createSelect(tempCollection->name());
+    select->setWhere(QStringLiteral("test_field_fire"), QStringLiteral("11s"));
+
+    auto cursor = driver.executeSelect(select);
+    cursor->waitForResult();
+
+    QVERIFY2(cursor->hasErrorOccurred() == false, cursor->errorMessage().toLocal8Bit());
+    QCOMPARE(cursor->count(), 1);
+
+    arangodb::Document * doc = cursor->data().first();
+    QCOMPARE(doc->collection(), tempCollection->name());
+    QCOMPARE(doc->isCurrent(), false);
+    QCOMPARE(doc->get(QStringLiteral("test")).toBool(), true);
+    QCOMPARE(doc->get(QStringLiteral("test_field_echo")).toDouble(), 3.2);
+    QCOMPARE(doc->get(QStringLiteral("test_field_fire")).toString(), QStringLiteral("11s"));
+}
+
 void QueriesTest::testGetMultipleDocsByWhere()
 {
     auto select = qb.createSelect(QStringLiteral("webuser"), 2);
@@ -253,6 +298,620 @@ void QueriesTest::testSetResultWithMultipleCollections()
     QCOMPARE(doc2->contains("temp_test_field_fire"), true);
 }
 
+void QueriesTest::testColumnarResult()
+{
+    auto select = qb.createSelect(tempCollection->name(), 2);
+    select->setColumnar(true);
+
+    auto cursor = driver.executeSelect(select);
+    cursor->waitForResult();
+
+    QVERIFY2(cursor->hasErrorOccurred() == false, cursor->errorMessage().toLocal8Bit());
+    QCOMPARE(cursor->isColumnar(), true);
+    QCOMPARE(cursor->count(), 2);
+    QCOMPARE(cursor->data().isEmpty(), true);
+
+    cursor->getMoreData();
+    cursor->waitForResult();
+
+    QCOMPARE(cursor->count(), 3);
+
+    arangodb::QBColumn echo = cursor->column(QStringLiteral("test_field_echo"));
+    QCOMPARE(echo.size(), 3);
+    QCOMPARE(echo.validCount(), 3);
+    QVERIFY(echo.type() == arangodb::QBColumn::Type::DoubleType);
+
+    arangodb::QBColumn test = cursor->column(QStringLiteral("test"));
+    QVERIFY(test.type() == arangodb::QBColumn::Type::BoolType);
+
+    arangodb::QBColumn fire = cursor->column(QStringLiteral("test_field_fire"));
+    QVERIFY(fire.type() == arangodb::QBColumn::Type::StringType);
+    QCOMPARE(fire.validCount(), 3);
+}
+
+void QueriesTest::testColumnOutOfRangeNumbers()
+{
+    arangodb::QBColumn column(QStringLiteral("number"));
+    column.append(QJsonValue(42));
+    column.append(QJsonValue(1e300));
+    column.append(QJsonValue(-9223372036854775808.0 * 2));
+
+    QVERIFY(column.type() == arangodb::QBColumn::Type::DoubleType);
+    QCOMPARE(column.doubleAt(0), 42.0);
+    QCOMPARE(column.doubleAt(1), 1e300);
+    QCOMPARE(column.doubleAt(2), -9223372036854775808.0 * 2);
+}
+
+void QueriesTest::testDisposeCursor()
+{
+    auto select = qb.createSelect(tempCollection->name(), 2);
+    select->setTtl(30);
+
+    auto cursor = driver.executeSelect(select);
+    QCOMPARE(driver.openCursorCount(), 1);
+
+    cursor->waitForResult();
+
+    QVERIFY2(cursor->hasErrorOccurred() == false, cursor->errorMessage().toLocal8Bit());
+    QCOMPARE(cursor->hasMore(), true);
+    QCOMPARE(driver.openCursorCount(), 1);
+    QCOMPARE(driver.openCursors().first().id, cursor->id());
+
+    cursor->dispose();
+
+    QCOMPARE(cursor->hasMore(), false);
+    QCOMPARE(cursor->count(), 2);
+    QCOMPARE(driver.openCursorCount(), 0);
+}
+
+void QueriesTest::testDisposePendingCursor()
+{
+    auto select = qb.createSelect(tempCollection->name(), 2);
+
+    auto cursor = driver.executeSelect(select);
+    cursor->dispose();
+
+    // Stays open until the first batch tells its id
+    QCOMPARE(driver.openCursorCount(), 1);
+
+    cursor->waitForResult();
+
+    QVERIFY2(cursor->hasErrorOccurred() == false, cursor->errorMessage().toLocal8Bit());
+    QCOMPARE(cursor->hasMore(), false);
+    QCOMPARE(driver.openCursorCount(), 0);
+}
+
+void QueriesTest::testParallelScan()
+{
+    arangodb::QBParallelScan scan(&driver, tempCollection->name(), 2, 1);
+    scan.setOrdered(true);
+
+    QStringList keys;
+    connect(&scan, &arangodb::QBParallelScan::documentsAvailable,
+            [&keys] (int, QList<arangodb::Document *> docs) {
+        for ( arangodb::Document * doc : docs ) {
+            keys << doc->key();
+        }
+    });
+
+    scan.start();
+    scan.waitUntilFinished();
+
+    QVERIFY2(scan.hasErrorOccurred() == false, scan.errorMessage().toLocal8Bit());
+    QCOMPARE(scan.isFinished(), true);
+    QCOMPARE(scan.count(), qint64(3));
+    QCOMPARE(scan.keyBoundaries().size(), 1);
+
+    // The order of the keys is the collation order of the
+    // server, so only the delivered keys are compared
+    auto cursor = driver.executeSelect(qb.createSelect(tempCollection->name()));
+    cursor->waitForResult();
+
+    QSet<QString> expectedKeys;
+    for ( arangodb::Document * doc : cursor->data() ) {
+        expectedKeys.insert(doc->key());
+    }
+
+    QCOMPARE(keys.size(), expectedKeys.size());
+    QCOMPARE(keys.toSet(), expectedKeys);
+
+    // Every further boundary is searched from the previous one on
+    arangodb::QBParallelScan threeParts(&driver, tempCollection->name(), 3, 1);
+    threeParts.start();
+    threeParts.waitUntilFinished();
+
+    QVERIFY2(threeParts.hasErrorOccurred() == false, threeParts.errorMessage().toLocal8Bit());
+    QCOMPARE(threeParts.count(), qint64(3));
+    QCOMPARE(threeParts.keyBoundaries().size(), 2);
+    QVERIFY(expectedKeys.contains(threeParts.keyBoundaries().first()));
+    QVERIFY(expectedKeys.contains(threeParts.keyBoundaries().last()));
+    QVERIFY(threeParts.keyBoundaries().first() != threeParts.keyBoundaries().last());
+}
+
+void QueriesTest::testExportAll()
+{
+    arangodb::Collection::ExportOptions options;
+    options.batchSize = 2;
+
+    auto cursor = tempCollection->exportAll(options);
+    cursor->waitForResult();
+
+    QVERIFY2(cursor->hasErrorOccurred() == false, cursor->errorMessage().toLocal8Bit());
+    QCOMPARE(cursor->count(), 2);
+    QCOMPARE(cursor->hasMore(), true);
+
+    cursor->getMoreData();
+    cursor->waitForResult();
+
+    QVERIFY2(cursor->hasErrorOccurred() == false, cursor->errorMessage().toLocal8Bit());
+    QCOMPARE(cursor->count(), 3);
+    QCOMPARE(cursor->hasMore(), false);
+
+    QSet<QString> expectedKeys;
+    for ( arangodb::Document * doc : cursor->data() ) {
+        expectedKeys.insert(doc->key());
+    }
+
+    // All batches are written to the device before ready is emitted
+    QBuffer buffer;
+    buffer.open(QIODevice::WriteOnly);
+
+    auto deviceCursor = tempCollection->exportAll(&buffer, options);
+    deviceCursor->waitForResult();
+
+    QVERIFY2(deviceCursor->hasErrorOccurred() == false, deviceCursor->errorMessage().toLocal8Bit());
+    QCOMPARE(deviceCursor->hasMore(), false);
+    QCOMPARE(deviceCursor->data().size(), 0);
+    QCOMPARE(deviceCursor->batchStatistics().size(), 2);
+
+    QVERIFY(buffer.data().endsWith('\n'));
+    const QList<QByteArray> lines = buffer.data().trimmed().split('\n');
+    QCOMPARE(lines.size(), 3);
+
+    QSet<QString> keys;
+    for ( const QByteArray & line : lines ) {
+        const QJsonObject row = QJsonDocument::fromJson(line).object();
+        QVERIFY(row.contains(QStringLiteral("test_field_echo")));
+        QVERIFY(row.contains(QStringLiteral("test_field_fire")));
+        keys.insert(row.value(QStringLiteral("_key")).toString());
+    }
+
+    QCOMPARE(keys, expectedKeys);
+}
+
+void QueriesTest::testWhereUsesBindVars()
+{
+    auto select = qb.createSelect(tempCollection->name());
+
+    select->setWhere(QStringLiteral("test_field_fire"), QStringLiteral("11s"));
+    QJsonObject first = QJsonDocument::fromJson(select->toJson()).object();
+
+    select->setWhere(QStringLiteral("test_field_fire"), QStringLiteral("---s"));
+    QJsonObject second = QJsonDocument::fromJson(select->toJson()).object();
+
+    QCOMPARE(first.value("query").toString(), second.value("query").toString());
+    QCOMPARE(select->isPrepared(), true);
+    QCOMPARE(second.value("bindVars").toObject().value("value0").toString(), QStringLiteral("---s"));
+
+    auto cursor = driver.executeSelect(select);
+    cursor->waitForResult();
+
+    QVERIFY2(cursor->hasErrorOccurred() == false, cursor->errorMessage().toLocal8Bit());
+    QCOMPARE(cursor->count(), 1);
+}
+
+void QueriesTest::testReservedBindVars()
+{
+    auto select = qb.createSelect(tempCollection->name());
+    select->setWhere(QStringLiteral("test_field_fire"), QStringLiteral("11s"));
+    select->setLimit(1, 1);
+
+    // The names of the select itself can not be overwritten
+    QCOMPARE(select->setBindVar(QStringLiteral("value0"), QStringLiteral("---s")), false);
+    QCOMPARE(select->setBindVar(QStringLiteral("value12"), 1), false);
+    QCOMPARE(select->setBindVar(QStringLiteral("keyFrom"), QStringLiteral("a")), false);
+    QCOMPARE(select->setBindVar(QStringLiteral("limitCount"), 5), false);
+    QCOMPARE(select->setBindVar(QStringLiteral("valueName"), 1), true);
+
+    QCOMPARE(select->bindVars().value(QStringLiteral("value0")).toString(), QStringLiteral("11s"));
+    QCOMPARE(select->bindVars().value(QStringLiteral("limitCount")).toInt(), 1);
+    QCOMPARE(select->bindVars().contains(QStringLiteral("keyFrom")), false);
+}
+
+void QueriesTest::testWhereExpression()
+{
+    using Operator = arangodb::QBSelect::Operator;
+
+    auto select = qb.createSelect(tempCollection->name());
+    select->andWhereExpression(select->documentVariable() + QStringLiteral(".test_field_echo > @minEcho"));
+    QCOMPARE(select->setBindVar(QStringLiteral("minEcho"), 40), true);
+
+    auto cursor = driver.executeSelect(select);
+    cursor->waitForResult();
+
+    QVERIFY2(cursor->hasErrorOccurred() == false, cursor->errorMessage().toLocal8Bit());
+    QCOMPARE(cursor->count(), 2);
+
+    // Own parameters and the ones of the select go together
+    select->andWhere(QStringLiteral("test"), Operator::Equal, false);
+    QCOMPARE(select->bindVars().size(), 2);
+
+    cursor = driver.executeSelect(select);
+    cursor->waitForResult();
+
+    QVERIFY2(cursor->hasErrorOccurred() == false, cursor->errorMessage().toLocal8Bit());
+    QCOMPARE(cursor->count(), 1);
+    QCOMPARE(cursor->data().first()->get(QStringLiteral("test_field_echo")).toInt(), 999);
+
+    select->orWhereExpression(select->documentVariable() + QStringLiteral(".test_field_fire == @fire"));
+    QCOMPARE(select->setBindVar(QStringLiteral("fire"), QStringLiteral("11s")), true);
+
+    cursor = driver.executeSelect(select);
+    cursor->waitForResult();
+
+    QVERIFY2(cursor->hasErrorOccurred() == false, cursor->errorMessage().toLocal8Bit());
+    QCOMPARE(cursor->count(), 2);
+}
+
+void QueriesTest::testComposedWhere()
+{
+    using Operator = arangodb::QBSelect::Operator;
+
+    auto select = qb.createSelect(tempCollection->name());
+    select->andWhere(QStringLiteral("test"), Operator::Equal, true);
+    select->andWhere(QStringLiteral("test_field_echo"), Operator::Greater, 10);
+    select->orWhere(QStringLiteral("test_field_fire"), Operator::Like, QStringLiteral("-ö%"));
+
+    QCOMPARE(select->bindVars().size(), 3);
+
+    auto cursor = driver.executeSelect(select);
+    cursor->waitForResult();
+
+    QVERIFY2(cursor->hasErrorOccurred() == false, cursor->errorMessage().toLocal8Bit());
+    QCOMPARE(cursor->count(), 2);
+
+    select->clearWhere();
+    QCOMPARE(select->bindVars().isEmpty(), true);
+}
+
+void QueriesTest::testSortLimitProjection()
+{
+    auto select = qb.createSelect(tempCollection->name());
+    select->setSort(QStringLiteral("test_field_echo"), arangodb::QBSelect::SortDirection::Descending);
+    select->setLimit(1, 1);
+    select->setProjection(QStringList() << QStringLiteral("test_field_echo"));
+
+    auto cursor = driver.executeSelect(select);
+    cursor->waitForResult();
+
+    QVERIFY2(cursor->hasErrorOccurred() == false, cursor->errorMessage().toLocal8Bit());
+    QCOMPARE(cursor->count(), 1);
+
+    arangodb::Document * doc = cursor->data().at(0);
+    QCOMPARE(doc->get(QStringLiteral("test_field_echo")).toInt(), 44);
+    QCOMPARE(doc->contains(QStringLiteral("test_field_fire")), false);
+
+    // Paging only changes the bind parameters
+    select->setLimit(2, 1);
+    QCOMPARE(select->isPrepared(), true);
+}
+
+void QueriesTest::testCollectAggregate()
+{
+    using AggregateFunction = arangodb::QBSelect::AggregateFunction;
+
+    auto select = qb.createSelect(tempCollection->name());
+    select->setCollect(QStringLiteral("test"));
+    select->addAggregate(QStringLiteral("total"), AggregateFunction::Sum, QStringLiteral("test_field_echo"));
+    select->setCountInto(QStringLiteral("amount"));
+    select->setSort(QStringLiteral("test"));
+    select->setColumnar(true);
+
+    auto cursor = driver.executeSelect(select);
+    cursor->waitForResult();
+
+    QVERIFY2(cursor->hasErrorOccurred() == false, cursor->errorMessage().toLocal8Bit());
+    QCOMPARE(cursor->count(), 2);
+
+    arangodb::QBColumn groups = cursor->column(QStringLiteral("test"));
+    arangodb::QBColumn totals = cursor->column(QStringLiteral("total"));
+    arangodb::QBColumn amounts = cursor->column(QStringLiteral("amount"));
+
+    QCOMPARE(groups.boolAt(0), false);
+    QCOMPARE(totals.doubleAt(0), 999.0);
+    QCOMPARE(amounts.int64At(0), qint64(1));
+    QCOMPARE(groups.boolAt(1), true);
+    QCOMPARE(totals.doubleAt(1), 47.2);
+    QCOMPARE(amounts.int64At(1), qint64(2));
+}
+
+void QueriesTest::testExplainAndStatistics()
+{
+    auto select = qb.createSelect(tempCollection->name());
+    select->setWhere(QStringLiteral("test"), true);
+
+    auto explain = driver.explain(select);
+    explain->waitForResult();
+
+    QVERIFY2(explain->hasErrorOccurred() == false, explain->errorMessage().toLocal8Bit());
+    QCOMPARE(explain->isFullScan(), true);
+    QCOMPARE(explain->usesIndex(), false);
+
+    select->setLimit(1);
+    select->setFullCount(true);
+    select->setProfiling(true);
+
+    auto cursor = driver.executeSelect(select);
+    cursor->waitForResult();
+
+    QVERIFY2(cursor->hasErrorOccurred() == false, cursor->errorMessage().toLocal8Bit());
+    QCOMPARE(cursor->count(), 1);
+    QCOMPARE(cursor->hasStatistics(), true);
+    QCOMPARE(cursor->statistics().scannedFull, qint64(3));
+    QCOMPARE(cursor->statistics().fullCount, qint64(2));
+}
+
+void QueriesTest::testCursorTotalCount()
+{
+    auto select = qb.createSelect(tempCollection->name(), 1);
+    select->setCounting(true);
+
+    auto cursor = driver.executeSelect(select);
+    cursor->waitForResult();
+
+    QVERIFY2(cursor->hasErrorOccurred() == false, cursor->errorMessage().toLocal8Bit());
+    QCOMPARE(cursor->count(), 1);
+    QCOMPARE(cursor->totalCount(), qint64(3));
+    QCOMPARE(cursor->batchStatistics().size(), 1);
+    QCOMPARE(cursor->batchStatistics().first().rows, 1);
+    QVERIFY(cursor->batchStatistics().first().bytes > 0);
+}
+
+void QueriesTest::testTraversalQuery()
+{
+    auto traversal = qb.createTraversal(QStringLiteral("persons/alice"), QStringLiteral("knows"));
+    traversal->setDirection(arangodb::QBTraversal::Direction::Any);
+    traversal->setDepth(1, 3);
+    traversal->setUniqueVertices(true);
+
+    QCOMPARE(traversal->query(),
+             QStringLiteral("FOR v, e, p IN @minDepth..@maxDepth ANY @start @@edges0 "
+                            "OPTIONS {bfs: true, uniqueVertices: \"global\"} RETURN v"));
+    QCOMPARE(traversal->bindVars().value(QStringLiteral("@edges0")).toString(), QStringLiteral("knows"));
+    QCOMPARE(traversal->bindVars().value(QStringLiteral("maxDepth")).toInt(), 3);
+
+    traversal->setShortestPath(QStringLiteral("persons/bob"));
+    QCOMPARE(traversal->query(),
+             QStringLiteral("FOR v, e IN ANY SHORTEST_PATH @start TO @target @@edges0 RETURN v"));
+    QCOMPARE(traversal->bindVars().contains(QStringLiteral("minDepth")), false);
+}
+
+void QueriesTest::testRequestStatistics()
+{
+    using Operation = arangodb::DriverStatistics::Operation;
+
+    driver.resetStatistics();
+
+    auto select = qb.createSelect(tempCollection->name(), 1);
+    auto cursor = driver.executeSelect(select);
+    cursor->waitForResult();
+
+    QVERIFY2(cursor->hasErrorOccurred() == false, cursor->errorMessage().toLocal8Bit());
+
+    auto statistics = driver.statistics();
+    QCOMPARE(statistics.operation(Operation::CursorCreate).requests, qint64(1));
+    QCOMPARE(statistics.operation(Operation::CursorCreate).errors, qint64(0));
+    QVERIFY(statistics.operation(Operation::CursorCreate).bytesReceived > 0);
+    QCOMPARE(statistics.operation(Operation::CursorCreate).latency.count(), qint64(1));
+    QCOMPARE(statistics.inFlight(), 0);
+
+    arangodb::LatencyHistogram histogram;
+    for (qint64 i = 1; i <= 1000; ++i) {
+        histogram.record(i);
+    }
+    QCOMPARE(histogram.count(), qint64(1000));
+    QVERIFY(qAbs(histogram.percentile(50.0) - 500) <= 500 / 16);
+    QVERIFY(qAbs(histogram.percentile(99.0) - 990) <= 990 / 16);
+
+    // Values on a fixed bound are counted in it, not above it
+    QCOMPARE(arangodb::LatencyHistogram::fixedBound(0), qint64(500));
+    QCOMPARE(histogram.fixedBoundCount(0), qint64(500));
+    QCOMPARE(histogram.fixedBoundCount(1), qint64(500));
+    QCOMPARE(histogram.fixedBoundCount(2), qint64(0));
+}
+
+void QueriesTest::testRequestTrace()
+{
+    arangodb::TraceEventWriter writer;
+    driver.setTraceCallback([&writer](const arangodb::RequestTrace & trace) {
+        writer.append(trace);
+    });
+
+    auto select = qb.createSelect(tempCollection->name(), 1);
+    auto cursor = driver.executeSelect(select);
+    cursor->waitForResult();
+
+    driver.setTraceCallback(nullptr);
+
+    QVERIFY2(cursor->hasErrorOccurred() == false, cursor->errorMessage().toLocal8Bit());
+    QCOMPARE(writer.size(), 1);
+
+    QJsonObject root = QJsonDocument::fromJson(writer.toJson()).object();
+    QJsonArray events = root.value(QStringLiteral("traceEvents")).toArray();
+    QVERIFY(events.size() >= 3);
+    QCOMPARE(events.first().toObject().value(QStringLiteral("name")).toString(), QStringLiteral("cursor_create"));
+    QCOMPARE(events.last().toObject().value(QStringLiteral("name")).toString(), QStringLiteral("decode"));
+}
+
+void QueriesTest::testMetricsExporter()
+{
+    auto select = qb.createSelect(tempCollection->name(), 1);
+    auto cursor = driver.executeSelect(select);
+    cursor->waitForResult();
+
+    arangodb::MetricsExporter exporter(&driver);
+    const QByteArray metrics = exporter.render();
+
+    QVERIFY(metrics.contains("arangodb_driver_requests_total{operation=\"cursor_create\"}"));
+    QVERIFY(metrics.contains("arangodb_driver_request_duration_seconds_bucket{operation=\"cursor_create\",le=\"+Inf\"}"));
+    QVERIFY(metrics.contains("arangodb_driver_in_flight_requests 0"));
+    QVERIFY(metrics.contains("# TYPE arangodb_driver_memory_bytes gauge\n"));
+    QVERIFY(metrics.contains("# UNIT arangodb_driver_memory_bytes bytes\n"));
+    QVERIFY(metrics.endsWith("# EOF\n"));
+
+    QVERIFY(exporter.listen());
+
+    auto scrape = [&exporter](const QByteArray & method) {
+        QTcpSocket socket;
+        socket.connectToHost(QHostAddress::LocalHost, exporter.serverPort());
+        socket.write(method + " /metrics HTTP/1.1\r\nHost: localhost\r\n\r\n");
+
+        QByteArray reply;
+        QEventLoop loop;
+        QObject::connect(&socket, &QTcpSocket::readyRead, [&] { reply += socket.readAll(); });
+        QObject::connect(&socket, &QTcpSocket::disconnected, &loop, &QEventLoop::quit);
+        QTimer::singleShot(5000, &loop, &QEventLoop::quit);
+        loop.exec();
+
+        return reply + socket.readAll();
+    };
+
+    const QByteArray getReply = scrape("GET");
+    const int getHeaderEnd = getReply.indexOf("\r\n\r\n");
+    QVERIFY(getReply.startsWith("HTTP/1.1 200 OK\r\n"));
+    QVERIFY(getHeaderEnd > 0);
+
+    const QByteArray getBody = getReply.mid(getHeaderEnd + 4);
+    QVERIFY(getBody.endsWith("# EOF\n"));
+    QVERIFY(getReply.contains("Content-Length: " + QByteArray::number(getBody.size()) + "\r\n"));
+
+    // HEAD announces the length of the body it leaves out
+    const QByteArray headReply = scrape("HEAD");
+    QVERIFY(headReply.startsWith("HTTP/1.1 200 OK\r\n"));
+    QVERIFY(headReply.endsWith("\r\n\r\n"));
+    QVERIFY(headReply.contains("Content-Length: "));
+    QVERIFY(headReply.contains("Content-Length: 0\r\n") == false);
+}
+
+void QueriesTest::testQueryFingerprint()
+{
+    using arangodb::QueryLog;
+
+    QCOMPARE(QueryLog::fingerprint(QStringLiteral("FOR v1 IN temp2  FILTER v1.name == \"a \\\" b\" && v1.age > 42.5\n"
+                                                  "LIMIT 0, 10 RETURN v1")),
+             QStringLiteral("FOR v1 IN temp2 FILTER v1.name == ? && v1.age > ? LIMIT ?, ? RETURN v1"));
+    QCOMPARE(QueryLog::fingerprint(QStringLiteral("FOR d IN `col 1` FILTER d.tag IN ['x', 'y', 'z'] RETURN d")),
+             QStringLiteral("FOR d IN `col 1` FILTER d.tag IN [?] RETURN d"));
+    QCOMPARE(QueryLog::fingerprint(QStringLiteral("FOR v IN 1..3 OUTBOUND @start @@edges RETURN v")),
+             QStringLiteral("FOR v IN ?..? OUTBOUND @start @@edges RETURN v"));
+
+    QVariantMap bindVars;
+    bindVars.insert(QStringLiteral("@coll"), QStringLiteral("temp"));
+    bindVars.insert(QStringLiteral("limit"), 10);
+    QCOMPARE(QueryLog::bindVarShape(bindVars), QStringLiteral("{@coll: collection, limit: number}"));
+
+    driver.resetQueryStatistics();
+
+    auto select = qb.createSelect(tempCollection->name(), 1);
+    auto cursor = driver.executeSelect(select);
+    cursor->waitForResult();
+
+    QVERIFY2(cursor->hasErrorOccurred() == false, cursor->errorMessage().toLocal8Bit());
+
+    auto queries = driver.queryStatistics();
+    QCOMPARE(queries.size(), 1);
+    QCOMPARE(queries.first().fingerprint, QueryLog::fingerprint(select->query()));
+    QCOMPARE(queries.first().count, qint64(1));
+    QCOMPARE(queries.first().rows, qint64(cursor->count()));
+
+    // A cursor writing to a device only signals its last batch
+    driver.resetQueryStatistics();
+
+    QBuffer buffer;
+    buffer.open(QIODevice::WriteOnly);
+
+    auto deviceCursor = driver.executeSelect(qb.createSelect(tempCollection->name(), 1));
+    deviceCursor->setOutputDevice(&buffer);
+    deviceCursor->waitForResult();
+
+    QVERIFY2(deviceCursor->hasErrorOccurred() == false, deviceCursor->errorMessage().toLocal8Bit());
+
+    queries = driver.queryStatistics();
+    QCOMPARE(queries.size(), 1);
+    QCOMPARE(queries.first().count, qint64(1));
+    QCOMPARE(queries.first().batches, qint64(3));
+    QCOMPARE(queries.first().rows, qint64(3));
+}
+
+void QueriesTest::testMemoryUsage()
+{
+    auto select = qb.createSelect(tempCollection->name(), 3);
+    auto cursor = driver.executeSelect(select);
+    cursor->waitForResult();
+
+    QVERIFY2(cursor->hasErrorOccurred() == false, cursor->errorMessage().toLocal8Bit());
+
+    // Other tests may still have documents waiting for deleteLater
+    const arangodb::MemoryUsage usage = driver.memoryUsage();
+    QVERIFY(usage.documentCount >= cursor->count());
+    QVERIFY(usage.documents > usage.documentCount * 100);
+    QVERIFY(usage.cursorBatches >= cursor->batchStatistics().first().bytes);
+
+    QSignalSpy exceeded(&driver, &arangodb::Arangodbdriver::memoryLimitExceeded);
+    driver.setMemorySoftLimit(1);
+    QCOMPARE(exceeded.count(), 1);
+    QVERIFY(driver.isOverMemoryLimit());
+
+    driver.setMemorySoftLimit(0);
+    QVERIFY(driver.isOverMemoryLimit() == false);
+}
+
+void QueriesTest::testAsyncDriver()
+{
+    arangodb::AsyncDriver asyncDriver;
+
+    bool isDone = false;
+    QThread * callbackThread = nullptr;
+    QList<QJsonObject> rows;
+    QString errorMessage;
+
+    // Batches of one row, so every row is another request on the I/O thread
+    asyncDriver.executeSelect(qb.createSelect(tempCollection->name(), 1),
+                              [&](const QList<QJsonObject> & result, const QString & error) {
+        callbackThread = QThread::currentThread();
+        rows = result;
+        errorMessage = error;
+        isDone = true;
+    });
+
+    QTRY_VERIFY(isDone);
+    QCOMPARE(callbackThread, QCoreApplication::instance()->thread());
+    QVERIFY2(errorMessage.isEmpty(), errorMessage.toLocal8Bit());
+    QCOMPARE(rows.size(), 3);
+}
+
+void QueriesTest::testBackgroundDecode()
+{
+    // Every batch is parsed on the thread pool
+    driver.setBackgroundDecodeThreshold(0);
+
+    auto select = qb.createSelect(tempCollection->name(), 1);
+    auto cursor = driver.executeSelect(select);
+    cursor->waitForResult();
+
+    while ( cursor->hasMore() && !cursor->hasErrorOccurred() ) {
+        cursor->getMoreData();
+        cursor->waitForResult();
+    }
+
+    driver.setBackgroundDecodeThreshold(1024 * 1024);
+
+    QVERIFY2(cursor->hasErrorOccurred() == false, cursor->errorMessage().toLocal8Bit());
+    QCOMPARE(cursor->count(), 3);
+    QCOMPARE(cursor->batchStatistics().size(), 3);
+    QVERIFY(cursor->data().first()->contains(QStringLiteral("_key")));
+}
+
 QTEST_MAIN(QueriesTest)
 
 #include "tst_QueriesTest.moc"
@@ -25,6 +25,7 @@
 #include <QtCore>
 #include <QtNetwork>
 #include <Arangodbdriver.h>
+#include <QueryBuilder.h>
 
 using namespace arangodb;
 
@@ -41,6 +42,7 @@ class StartTest : public QObject
     private Q_SLOTS:
         void initTestCase();
         void cleanupTestCase();
+        void cleanup();
         void testDocumentSaveAndDelete();
         void testDocumentSave2Times();
         void testDocumentPartialUpdate();
@@ -48,6 +50,11 @@ class StartTest : public QObject
         void testEdgeSaveAndDelete();
         void testEdgePartialUpdate();
         void testEdgeHeadOperation();
+        void testEdgeImport();
+        void testEdgeImportWait();
+        void testEdgeImportQueueBound();
+        void testAdjacencyCache();
+        void testTraversal();
 
     private:
         /**
@@ -71,6 +78,12 @@ class StartTest : public QObject
             connect(doc, &Document::dataDeleted, &loop, &QEventLoop::quit);
             loop.exec();
         }
+
+        /**
+         * @brief Ids of the edges a test created in the
+         * shared collection, removed after every test
+         */
+        QStringList createdEdges;
 };
 
 /**
@@ -94,6 +107,26 @@ void StartTest::cleanupTestCase()
 {
 }
 
+/**
+ * @brief StartTest::cleanup
+ */
+void StartTest::cleanup()
+{
+    Arangodbdriver driver;
+
+    for ( const QString & id : createdEdges ) {
+        Edge *edge = driver.getEdge(id);
+        waitForDocumentReady(edge);
+
+        if ( edge->isCreated() ) {
+            edge->drop();
+            waitForDocumentDeleted(edge);
+        }
+    }
+
+    createdEdges.clear();
+}
+
 /**
  * @brief StartTest::testDocumentSaveAndDelete
  */
@@ -361,6 +394,228 @@ void StartTest::testEdgeHeadOperation()
     doc2->drop();
 }
 
+/**
+ * @brief StartTest::testEdgeImport
+ */
+void StartTest::testEdgeImport()
+{
+    Arangodbdriver driver;
+    Document *doc1 = driver.createDocument("test");
+    Document *doc2 = driver.createDocument("test");
+
+    doc1->save();
+    waitForDocumentReady(doc1);
+
+    doc2->save();
+    waitForDocumentReady(doc2);
+
+    EdgeImport *import = driver.createEdgeImport("fubar", 2);
+    QSignalSpy sentChunks(import, &EdgeImport::sendChunk);
+
+    for (int i = 0; i < 5; ++i) {
+        QJsonObject attributes;
+        attributes.insert("number", i);
+        import->addEdge(doc1->docID(), doc2->docID(), attributes);
+    }
+    import->finish();
+    import->waitUntilFinished();
+
+    QCOMPARE( import->created(), qint64(5) );
+    QCOMPARE( import->errors(), qint64(0) );
+
+    // Without the adjacency cache the vertices are not collected
+    QCOMPARE( sentChunks.count(), 3 );
+    for ( const QList<QVariant> & arguments : sentChunks ) {
+        QCOMPARE( arguments.at(3).toStringList(), QStringList() );
+    }
+
+    auto cursor = driver.getEdges("fubar", doc1->docID(), QBTraversal::Direction::Outbound);
+    cursor->waitForResult();
+
+    for ( Document *edge : cursor->data() ) {
+        createdEdges.append(edge->docID());
+    }
+
+    QVERIFY2( cursor->hasErrorOccurred() == false, cursor->errorMessage().toLocal8Bit() );
+    QCOMPARE( cursor->count(), 5 );
+
+    doc1->drop();
+    doc2->drop();
+}
+
+/**
+ * @brief StartTest::testEdgeImportWait
+ */
+void StartTest::testEdgeImportWait()
+{
+    // Not created by a driver, so no chunk is ever imported
+    EdgeImport import("fubar", 2);
+    import.addEdge("test/1", "test/2");
+
+    QCOMPARE( import.waitUntilFinished(), false );
+
+    import.finish();
+    QCOMPARE( import.waitUntilFinished(50), false );
+    QCOMPARE( import.isFinished(), false );
+}
+
+/**
+ * @brief StartTest::testEdgeImportQueueBound
+ */
+void StartTest::testEdgeImportQueueBound()
+{
+    // Not created by a driver, so the running chunk never finishes
+    EdgeImport import("fubar", 1);
+    import.setMaxRunningChunks(1);
+    import.setMaxPendingChunks(2);
+
+    QCOMPARE( import.addEdge("test/1", "test/2"), true );
+    QCOMPARE( import.pendingChunks(), 0 );
+    QCOMPARE( import.addEdge("test/1", "test/3"), true );
+    QCOMPARE( import.addEdge("test/1", "test/4"), true );
+    QCOMPARE( import.pendingChunks(), 2 );
+    QCOMPARE( import.isFull(), true );
+
+    QCOMPARE( import.addEdge("test/1", "test/5"), false );
+    QCOMPARE( import.pendingChunks(), 2 );
+}
+
+/**
+ * @brief StartTest::testAdjacencyCache
+ */
+void StartTest::testAdjacencyCache()
+{
+    Arangodbdriver driver;
+    driver.setAdjacencyCacheEnabled(true);
+
+    Document *doc1 = driver.createDocument("test");
+    Document *doc2 = driver.createDocument("test");
+
+    doc1->save();
+    waitForDocumentReady(doc1);
+
+    doc2->save();
+    waitForDocumentReady(doc2);
+
+    Edge *e1 = driver.createEdge("fubar", doc1, doc2);
+    e1->save();
+    waitForDocumentReady(e1);
+    createdEdges.append(e1->docID());
+
+    AdjacencyList list = driver.adjacency("fubar", doc1->docID(), QBTraversal::Direction::Outbound);
+    QCOMPARE( list.size(), 1 );
+    QCOMPARE( list.neighborAt(0), doc2->docID() );
+    QCOMPARE( list.edgeKeyAt(0), e1->key() );
+
+    // Answered from the cache without waiting
+    AdjacencyList cachedList;
+    QString errorMessage = "not called";
+    driver.loadAdjacency("fubar", doc1->docID(), QBTraversal::Direction::Outbound,
+                         [&](const AdjacencyList & loaded, const QString & message) {
+        cachedList = loaded;
+        errorMessage = message;
+    });
+    QCOMPARE( errorMessage, QString() );
+    QCOMPARE( cachedList.size(), 1 );
+    QCOMPARE( driver.adjacencyCacheStatistics().hits, qint64(1) );
+    QCOMPARE( driver.adjacencyCacheStatistics().misses, qint64(1) );
+
+    Edge *e2 = driver.createEdge("fubar", doc1, doc2);
+    e2->save();
+    waitForDocumentReady(e2);
+    createdEdges.append(e2->docID());
+
+    list = driver.adjacency("fubar", doc1->docID(), QBTraversal::Direction::Outbound);
+    QCOMPARE( list.size(), 2 );
+    QCOMPARE( driver.adjacencyCacheStatistics().invalidations, qint64(1) );
+
+    doc1->drop();
+    doc2->drop();
+}
+
+/**
+ * @brief StartTest::testTraversal
+ */
+void StartTest::testTraversal()
+{
+    Arangodbdriver driver;
+    QueryBuilder qb;
+
+    Document *doc1 = driver.createDocument("test");
+    Document *doc2 = driver.createDocument("test");
+    Document *doc3 = driver.createDocument("test");
+
+    doc1->save();
+    waitForDocumentReady(doc1);
+    doc2->save();
+    waitForDocumentReady(doc2);
+    doc3->save();
+    waitForDocumentReady(doc3);
+
+    Edge *e1 = driver.createEdge("fubar", doc1, doc2);
+    e1->save();
+    waitForDocumentReady(e1);
+    createdEdges.append(e1->docID());
+
+    Edge *e2 = driver.createEdge("fubar", doc2, doc3);
+    e2->save();
+    waitForDocumentReady(e2);
+    createdEdges.append(e2->docID());
+
+    auto traversal = qb.createTraversal(doc1->docID(), "fubar");
+    traversal->setDirection(QBTraversal::Direction::Outbound);
+    traversal->setDepth(1, 2);
+
+    auto cursor = driver.executeTraversal(traversal);
+    cursor->waitForResult();
+
+    QVERIFY2( cursor->hasErrorOccurred() == false, cursor->errorMessage().toLocal8Bit() );
+    QCOMPARE( cursor->count(), 2 );
+
+    QSet<QString> vertices;
+    for ( Document * vertex : cursor->data() ) {
+        vertices.insert(vertex->docID());
+    }
+    QCOMPARE( vertices, QSet<QString>() << doc2->docID() << doc3->docID() );
+
+    // Nothing leads back to the start vertex
+    traversal->setDirection(QBTraversal::Direction::Inbound);
+    cursor = driver.executeTraversal(traversal);
+    cursor->waitForResult();
+
+    QVERIFY2( cursor->hasErrorOccurred() == false, cursor->errorMessage().toLocal8Bit() );
+    QCOMPARE( cursor->count(), 0 );
+
+    traversal->setDirection(QBTraversal::Direction::Outbound);
+    traversal->setShortestPath(doc3->docID());
+    cursor = driver.executeTraversal(traversal);
+    cursor->waitForResult();
+
+    QVERIFY2( cursor->hasErrorOccurred() == false, cursor->errorMessage().toLocal8Bit() );
+    QCOMPARE( cursor->count(), 3 );
+    QCOMPARE( cursor->data().at(0)->docID(), doc1->docID() );
+    QCOMPARE( cursor->data().at(1)->docID(), doc2->docID() );
+    QCOMPARE( cursor->data().at(2)->docID(), doc3->docID() );
+
+    traversal->setResultType(QBTraversal::ResultType::Edges);
+    cursor = driver.executeTraversal(traversal);
+    cursor->waitForResult();
+
+    // The start vertex has no edge leading to it
+    QVERIFY2( cursor->hasErrorOccurred() == false, cursor->errorMessage().toLocal8Bit() );
+    QCOMPARE( cursor->count(), 3 );
+
+    QStringList edges;
+    for ( Document * edge : cursor->data() ) {
+        if ( edge->contains("_id") ) edges.append(edge->docID());
+    }
+    QCOMPARE( edges, QStringList() << e1->docID() << e2->docID() );
+
+    doc1->drop();
+    doc2->drop();
+    doc3->drop();
+}
+
 QTEST_MAIN(StartTest)
 
 #include "tst_StartTest.moc"